@@ -0,0 +1,59 @@
+"""Per-call overhead of the tiny Tron accessors, in nanoseconds.
+
+Run against two builds (e.g. before/after a dispatch change) and compare:
+
+    uv run python examples/call_overhead_benchmark.py
+"""
+
+import sys
+import timeit
+
+from tron import Key, Tron
+
+
+def _setup() -> dict[str, object]:
+    tron = Tron()
+    tron.set_i64("lap", 55)
+    tron.set_f64("time_sec", 88.427)
+    tron.set_str("event", "lap_complete")
+    items_ofs = tron.set_arr("items")
+    for value in range(16):
+        tron.arr_append_i64(value, ofs=items_ofs)
+    return {"Tron": Tron, "tron": tron, "items_ofs": items_ofs, "LAP": Key("lap")}
+
+
+CASES = [
+    ("Tron()", "Tron()"),
+    ("get_i64(str)", "tron.get_i64('lap')"),
+    ("get_i64(Key)", "tron.get_i64(LAP)"),
+    ("get_i64(str, ofs=0)", "tron.get_i64('lap', ofs=0)"),
+    ("get_f64(str)", "tron.get_f64('time_sec')"),
+    ("get_str(str)", "tron.get_str('event')"),
+    ("get(str)", "tron.get('lap')"),
+    ("exists(str)", "tron.exists('lap')"),
+    ("set_i64(str)", "tron.set_i64('lap', 56)"),
+    ("set_i64(Key)", "tron.set_i64(LAP, 56)"),
+    ("arr_get_i64(i, ofs)", "tron.arr_get_i64(3, items_ofs)"),
+    ("arr_get_i64(i, ofs=)", "tron.arr_get_i64(3, ofs=items_ofs)"),
+    ("buflen()", "tron.buflen()"),
+]
+
+
+def _ns_per_call(stmt: str, namespace: dict[str, object], number: int, repeat: int) -> float:
+    timer = timeit.Timer(stmt, globals=namespace)
+    return min(timer.repeat(repeat=repeat, number=number)) / number * 1e9
+
+
+def main() -> None:
+    number = int(sys.argv[1]) if len(sys.argv) > 1 else 200_000
+    repeat = 5
+    namespace = _setup()
+
+    width = max(len(name) for name, _ in CASES)
+    print(f"{'call':<{width}}  ns/call  (best of {repeat} x {number:,})")
+    for name, stmt in CASES:
+        print(f"{name:<{width}}  {_ns_per_call(stmt, namespace, number, repeat):7.1f}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,58 @@
+"""Records <-> columns: Python loops vs. one to_columns() scan / from_columns() build.
+
+    uv run python examples/columns_benchmark.py [records]
+"""
+
+import sys
+import time
+from array import array
+
+from tron import Tron
+
+
+def _timed(label: str, fn):
+    start = time.perf_counter()
+    result = fn()
+    print(f"{label:>22}: {(time.perf_counter() - start) * 1e3:8.2f} ms")
+    return result
+
+
+def main() -> None:
+    records = int(sys.argv[1]) if len(sys.argv) > 1 else 200_000
+    tron = Tron.from_obj(
+        {"items": [{"id": i, "ts": 1_700_000_000 + i, "score": i * 0.25, "name": f"user-{i}"} for i in range(records)]}
+    )
+    items = tron.get_arr("items")
+    print(f"{records:,} records, {tron.buflen():,} bytes")
+
+    def python_loop():
+        ids, ts, scores, names = array("q"), array("q"), array("d"), []
+        for record in tron.view(items):
+            ids.append(record["id"])
+            ts.append(record["ts"])
+            scores.append(record["score"])
+            names.append(record["name"])
+        return ids, ts, scores, names
+
+    _timed("python loop", python_loop)
+    cols = _timed("to_columns", lambda: tron.to_columns(items, ["id", "ts", "score", "name"], ["i64", "i64", "f64", "str"]))
+
+    def python_build():
+        out = Tron(root="array")
+        ids, ts, scores = cols["id"], cols["ts"], cols["score"]
+        offsets, data = cols["name"]
+        for i in range(records):
+            rec = out.arr_append_obj()
+            out.set_i64("id", ids[i], rec)
+            out.set_i64("ts", ts[i], rec)
+            out.set_f64("score", scores[i], rec)
+            out.set_str("name", data[offsets[i] : offsets[i + 1]].decode(), rec)
+        return out
+
+    built = _timed("python build", python_build)
+    rebuilt = _timed("from_columns", lambda: Tron.from_columns(cols))
+    assert rebuilt.to_obj() == built.to_obj()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,50 @@
+"""Accessor throughput on 1..N threads; meaningful on a free-threaded (3.13t) interpreter.
+
+"private" gives each thread its own Tron (should scale with cores), "shared" has every
+thread hammer one Tron (serialized by its critical section, but never corrupted).
+
+    uv run --python 3.13t python examples/free_threading_benchmark.py [threads] [ops]
+"""
+
+import os
+import sys
+import threading
+import time
+
+from tron import Tron
+
+
+def _work(tron: Tron, key: str, ops: int) -> None:
+    for i in range(ops):
+        tron.set_i64(key, i)
+        tron.get_i64(key)
+
+
+def _run(threads: int, ops: int, shared: bool) -> float:
+    common = Tron()
+    trons = [common if shared else Tron() for _ in range(threads)]
+    workers = [threading.Thread(target=_work, args=(trons[i], f"k{i}", ops)) for i in range(threads)]
+    start = time.perf_counter()
+    for worker in workers:
+        worker.start()
+    for worker in workers:
+        worker.join()
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else min(8, os.cpu_count() or 1)
+    ops = int(sys.argv[2]) if len(sys.argv) > 2 else 200_000
+    gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(f"GIL enabled: {gil}, {ops:,} set+get pairs per thread")
+    print(f"{'threads':>7}  {'private Mops/s':>14}  {'shared Mops/s':>13}")
+    threads = 1
+    while threads <= max_threads:
+        private = threads * ops / _run(threads, ops, shared=False) / 1e6
+        shared = threads * ops / _run(threads, ops, shared=True) / 1e6
+        print(f"{threads:>7}  {private:14.2f}  {shared:13.2f}")
+        threads *= 2
+
+
+if __name__ == "__main__":
+    main()
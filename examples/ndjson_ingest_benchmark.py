@@ -0,0 +1,62 @@
+"""NDJSON ingest: a Python line loop over Tron.from_json vs. tron.iter_ndjson.
+
+    uv run python examples/ndjson_ingest_benchmark.py [lines]
+"""
+
+import io
+import json
+import os
+import sys
+import tempfile
+import time
+
+from tron import Tron, iter_ndjson, ndjson_to_stream
+
+
+def _python_loop(path: str) -> int:
+    count = 0
+    with open(path, encoding="utf-8") as fp:
+        for line in fp:
+            if line.strip():
+                Tron.from_json(line)
+                count += 1
+    return count
+
+
+def _iter_ndjson(path: str) -> int:
+    return sum(1 for _ in iter_ndjson(path))
+
+
+def _iter_ndjson_reuse(path: str) -> int:
+    return sum(1 for _ in iter_ndjson(path, reuse=True))
+
+
+def _to_stream(path: str) -> int:
+    return ndjson_to_stream(path, io.BytesIO())
+
+
+def main() -> None:
+    lines = int(sys.argv[1]) if len(sys.argv) > 1 else 200_000
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "events.ndjson")
+        with open(path, "w", encoding="utf-8") as fp:
+            for i in range(lines):
+                fp.write(json.dumps({"seq": i, "event": "lap_complete", "time_sec": i * 0.25, "tags": ["a", "b"]}))
+                fp.write("\n")
+        size_mb = os.path.getsize(path) / 1e6
+
+        print(f"{lines:,} lines, {size_mb:.1f} MB")
+        for name, fn in [
+            ("python loop + from_json", _python_loop),
+            ("iter_ndjson", _iter_ndjson),
+            ("iter_ndjson(reuse=True)", _iter_ndjson_reuse),
+            ("ndjson_to_stream", _to_stream),
+        ]:
+            start = time.perf_counter()
+            assert fn(path) == lines
+            elapsed = time.perf_counter() - start
+            print(f"{name:<26} {elapsed:7.3f} s  {size_mb / elapsed:8.1f} MB/s")
+
+
+if __name__ == "__main__":
+    main()
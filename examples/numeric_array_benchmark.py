@@ -0,0 +1,40 @@
+"""Telemetry-style numeric arrays: per-element calls vs. one bulk call.
+
+    uv run python examples/numeric_array_benchmark.py [samples]
+"""
+
+import sys
+import time
+from array import array
+
+from tron import Tron
+
+
+def _timed(label: str, fn) -> None:
+    start = time.perf_counter()
+    fn()
+    print(f"{label:>26}: {(time.perf_counter() - start) * 1e3:8.2f} ms")
+
+
+def main() -> None:
+    samples = int(sys.argv[1]) if len(sys.argv) > 1 else 1_000_000
+    data = array("d", (i * 0.001 for i in range(samples)))
+    print(f"{samples:,} float64 samples")
+
+    looped = Tron(root="array")
+    bulk = Tron(root="array")
+
+    def append_loop() -> None:
+        append = looped.arr_append_f64
+        for value in data:
+            append(value)
+
+    _timed("arr_append_f64 loop", append_loop)
+    _timed("arr_extend_f64", lambda: bulk.arr_extend_f64(data))
+    _timed("arr_get_f64 loop", lambda: [looped.arr_get_f64(i) for i in range(samples)])
+    _timed("arr_to_buffer", lambda: bulk.arr_to_buffer(0, "d"))
+    assert bulk.arr_to_buffer(0, "d") == data
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,54 @@
+"""Per-request document churn: fresh Tron vs Pool.acquire() vs one Tron.reset().
+
+    uv run python examples/pool_benchmark.py [requests] [bufsz]
+"""
+
+import sys
+import time
+
+from tron import Pool, Tron
+
+
+def _fill(tron: Tron) -> None:
+    tron.set_str("method", "GET")
+    tron.set_str("path", "/api/v1/items")
+    tron.set_i64("status", 200)
+    tron.set_f64("latency_ms", 1.25)
+    headers = tron.set_obj("headers")
+    tron.set_str("host", "example.org", headers)
+    tron.set_str("user-agent", "bench/1.0", headers)
+    tron.to_json_bytes()
+
+
+def _fresh(requests: int, bufsz: int) -> None:
+    for _ in range(requests):
+        _fill(Tron(bufsz=bufsz))
+
+
+def _pooled(requests: int, bufsz: int) -> None:
+    pool = Pool(bufsz=bufsz, max_idle=4)
+    for _ in range(requests):
+        with pool.acquire() as tron:
+            _fill(tron)
+
+
+def _reset(requests: int, bufsz: int) -> None:
+    tron = Tron(bufsz=bufsz)
+    for _ in range(requests):
+        tron.reset()
+        _fill(tron)
+
+
+def main() -> None:
+    requests = int(sys.argv[1]) if len(sys.argv) > 1 else 200_000
+    bufsz = int(sys.argv[2]) if len(sys.argv) > 2 else 64 * 1024
+    print(f"{requests:,} requests, bufsz={bufsz:,}")
+    for name, fn in (("fresh Tron", _fresh), ("Pool.acquire", _pooled), ("Tron.reset", _reset)):
+        start = time.perf_counter()
+        fn(requests, bufsz)
+        elapsed = time.perf_counter() - start
+        print(f"{name:>12}: {elapsed:7.3f}s  {requests / elapsed / 1e3:8.1f} k req/s")
+
+
+if __name__ == "__main__":
+    main()
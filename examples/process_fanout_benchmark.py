@@ -0,0 +1,60 @@
+"""Fan documents out to a ProcessPoolExecutor: dict pickling vs Tron pickling vs shared memory.
+
+    uv run python examples/process_fanout_benchmark.py [docs] [items_per_doc]
+"""
+
+import sys
+import time
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import shared_memory
+
+from tron import Tron
+
+
+def _count_dict(doc: dict) -> int:
+    return len(doc["items"])
+
+
+def _count_tron(doc: Tron) -> int:
+    return doc.count(doc.get_arr("items"))
+
+
+def _count_shm(name: str) -> int:
+    shm = shared_memory.SharedMemory(name=name)
+    doc = Tron.from_shared_memory(shm)
+    try:
+        return doc.count(doc.get_arr("items"))
+    finally:
+        del doc
+        shm.close()
+
+
+def _timed(label: str, fn, args) -> None:
+    with ProcessPoolExecutor(max_workers=2) as pool:
+        list(pool.map(fn, args[:2]))
+        start = time.perf_counter()
+        total = sum(pool.map(fn, args))
+        elapsed = time.perf_counter() - start
+    print(f"{label:>14}: {elapsed:7.3f}s  ({total:,} items)")
+
+
+def main() -> None:
+    docs = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+    items = int(sys.argv[2]) if len(sys.argv) > 2 else 5_000
+    obj = {"items": [{"id": i, "name": f"item-{i}", "score": i * 0.5} for i in range(items)]}
+    tron = Tron.from_obj(obj)
+    print(f"{docs} documents of {tron.buflen():,} bytes")
+
+    _timed("pickled dict", _count_dict, [obj] * docs)
+    _timed("pickled Tron", _count_tron, [tron] * docs)
+    segments = [tron.to_shared_memory() for _ in range(docs)]
+    try:
+        _timed("shared memory", _count_shm, [shm.name for shm in segments])
+    finally:
+        for shm in segments:
+            shm.close()
+            shm.unlink()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,40 @@
+"""status == "active" and score > 0.9 over an array of records: Python loop vs. select().
+
+    uv run python examples/select_benchmark.py [records]
+"""
+
+import sys
+import time
+
+from tron import Predicate, Tron
+
+
+def _timed(label: str, fn):
+    start = time.perf_counter()
+    result = fn()
+    print(f"{label:>18}: {(time.perf_counter() - start) * 1e3:8.2f} ms  ({len(result):,} matches)")
+    return result
+
+
+def main() -> None:
+    records = int(sys.argv[1]) if len(sys.argv) > 1 else 500_000
+    statuses = ("active", "idle", "banned")
+    tron = Tron.from_obj(
+        {"items": [{"id": i, "status": statuses[i % 3], "score": (i * 7919 % 1000) / 1000} for i in range(records)]}
+    )
+    items = tron.get_arr("items")
+    print(f"{records:,} records")
+
+    def python_loop():
+        return [
+            i for i, rec in enumerate(tron.view(items)) if rec["status"] == "active" and rec["score"] > 0.9
+        ]
+
+    where = Predicate(("and", ("==", "status", "active"), (">", "score", 0.9)))
+    expected = _timed("python loop", python_loop)
+    assert _timed("select", lambda: tron.select(items, where=where)) == expected
+    _timed("select + project", lambda: tron.select(items, where=where, project=["id", "score"]))
+
+
+if __name__ == "__main__":
+    main()
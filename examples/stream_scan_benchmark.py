@@ -0,0 +1,43 @@
+"""Write a framed TRON event log, then scan it back through an mmap without copying.
+
+    uv run python examples/stream_scan_benchmark.py [records]
+"""
+
+import os
+import sys
+import tempfile
+import time
+
+from tron import StreamReader, StreamWriter, Tron
+
+
+def main() -> None:
+    records = int(sys.argv[1]) if len(sys.argv) > 1 else 200_000
+    template = Tron.from_obj({"seq": 0, "event": "lap_complete", "time_sec": 88.427, "tags": ["a", "b", "c"]})
+
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, "events.tronstream")
+
+        start = time.perf_counter()
+        with open(path, "wb") as fp, StreamWriter(fp) as writer:
+            for i in range(records):
+                template.set_i64("seq", i)
+                writer.write(template)
+        write_s = time.perf_counter() - start
+        size_mb = os.path.getsize(path) / 1e6
+
+        start = time.perf_counter()
+        total = 0
+        with StreamReader(path) as reader:
+            for record in reader:
+                total += record.get_i64("seq")
+        scan_s = time.perf_counter() - start
+        assert total == records * (records - 1) // 2
+
+    print(f"{records:,} records, {size_mb:.1f} MB")
+    print(f"write  {write_s:7.3f} s  {records / write_s / 1e6:6.2f} M rec/s  {size_mb / write_s:8.1f} MB/s")
+    print(f"scan   {scan_s:7.3f} s  {records / scan_s / 1e6:6.2f} M rec/s  {size_mb / scan_s:8.1f} MB/s")
+
+
+if __name__ == "__main__":
+    main()
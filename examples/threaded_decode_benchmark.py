@@ -0,0 +1,59 @@
+"""Decode independent JSON documents on 1..N threads; from_json/to_json release the GIL.
+
+    uv run python examples/threaded_decode_benchmark.py [threads] [docs_per_thread]
+"""
+
+import json
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from tron import Tron
+
+
+def _document(seed: int, rows: int = 20_000) -> str:
+    return json.dumps(
+        {
+            "seed": seed,
+            "rows": [
+                {"id": i, "name": f"row-{seed}-{i}", "score": i * 0.5, "tags": ["a", "b", str(i % 7)]}
+                for i in range(rows)
+            ],
+        }
+    )
+
+
+def _work(payload: str, repeat: int) -> int:
+    total = 0
+    for _ in range(repeat):
+        total += Tron.from_json(payload).buflen()
+    return total
+
+
+def _run(payloads: list[str], threads: int, repeat: int) -> float:
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=threads) as pool:
+        list(pool.map(_work, payloads[:threads], [repeat] * threads))
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else min(8, os.cpu_count() or 1)
+    repeat = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+    payloads = [_document(seed) for seed in range(max_threads)]
+    mb = len(payloads[0]) / 1e6
+
+    base = _run(payloads, 1, repeat)
+    print(f"document {mb:.1f} MB, {repeat} decodes per thread")
+    print(f"{'threads':>7}  {'seconds':>8}  {'MB/s':>8}  speedup")
+    threads = 1
+    while threads <= max_threads:
+        elapsed = base if threads == 1 else _run(payloads, threads, repeat)
+        throughput = threads * repeat * mb / elapsed
+        print(f"{threads:>7}  {elapsed:8.3f}  {throughput:8.1f}  {threads * base / elapsed:6.2f}x")
+        threads *= 2
+
+
+if __name__ == "__main__":
+    main()
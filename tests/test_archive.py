@@ -0,0 +1,76 @@
+import struct
+
+import pytest
+
+from tron import Archive, ArchiveWriter, FrozenTron, Tron, TronError
+
+
+def _user(i: int) -> Tron:
+    return Tron.from_obj({"id": i, "name": f"user-{i}", "roles": ["reader"] * (i % 3)})
+
+
+def test_archive_roundtrip(tmp_path):
+    path = tmp_path / "users.tronarc"
+    with ArchiveWriter(path) as writer:
+        for i in range(100):
+            writer.add(f"u{i}", _user(i))
+        assert len(writer) == 100
+
+    with Archive.open(path) as archive:
+        assert len(archive) == 100
+        doc = archive["u42"]
+        assert isinstance(doc, FrozenTron)
+        assert doc.to_obj() == _user(42).to_obj()
+        assert "u99" in archive and "u100" not in archive and 3 not in archive
+        assert archive.get("missing") is None
+        assert list(archive)[:3] == ["u0", "u1", "u2"]
+        with pytest.raises(KeyError):
+            archive["missing"]
+        del doc
+
+
+def test_duplicate_ids_and_empty_archive(tmp_path):
+    path = tmp_path / "empty.tronarc"
+    with ArchiveWriter(path) as writer:
+        writer.add("a", _user(1))
+        with pytest.raises(ValueError):
+            writer.add("a", _user(2))
+
+    empty = tmp_path / "none.tronarc"
+    ArchiveWriter(empty).close()
+    with Archive.open(empty) as archive:
+        assert len(archive) == 0 and list(archive) == [] and "a" not in archive
+
+
+def test_corrupt_archive(tmp_path):
+    path = tmp_path / "bad.tronarc"
+    path.write_bytes(b"TRONARC1" + bytes(40))
+    with pytest.raises(TronError):
+        Archive.open(path)
+
+
+def test_archive_input_errors(tmp_path):
+    path = tmp_path / "a.tronarc"
+    with ArchiveWriter(path) as writer:
+        with pytest.raises(TypeError, match="str"):
+            writer.add(b"a", _user(1))
+        writer.add("a", _user(1))
+
+    # Fill the one empty slot so a miss has nowhere to stop probing.
+    data = bytearray(path.read_bytes())
+    count, nslots, table_ofs, _ = struct.unpack_from("<QQQ8s", data, len(data) - 32)
+    assert (count, nslots) == (1, 2)
+    for slot in range(nslots):
+        ofs = table_ofs + slot * 32
+        if not struct.unpack_from("<Q", data, ofs + 24)[0]:
+            struct.pack_into("<IIQQQ", data, ofs, 0, 1, 8, 8, 8)
+    path.write_bytes(data)
+    with Archive.open(path) as archive:
+        assert "a" in archive
+        with pytest.raises(TronError, match="no empty slot"):
+            "missing" in archive
+
+    empty = tmp_path / "empty.tronarc"
+    empty.write_bytes(b"")
+    with pytest.raises(TronError, match="empty file"):
+        Archive.open(empty)
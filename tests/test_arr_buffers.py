@@ -0,0 +1,80 @@
+from array import array
+
+import pytest
+
+from tron import Pool, Tron, TronError
+
+
+def test_extend_and_export_round_trip():
+    tron = Tron()
+    ints = tron.set_arr("ints")
+    floats = tron.set_arr("floats")
+    tron.arr_extend_i64(array("q", [1, -2, 3]), ofs=ints)
+    tron.arr_extend_i64(array("i", [4]), ofs=ints)
+    tron.arr_extend_i64(memoryview(bytes([5, 6])), ofs=ints)
+    tron.arr_extend_f64(array("d", [0.5, 1.5]), ofs=floats)
+    tron.arr_extend_f64(array("f", [2.5]), ofs=floats)
+    assert tron.to_obj() == {"ints": [1, -2, 3, 4, 5, 6], "floats": [0.5, 1.5, 2.5]}
+
+    assert tron.arr_to_buffer(ints, "q") == array("q", [1, -2, 3, 4, 5, 6])
+    assert tron.arr_to_buffer(ints) == array("d", [1, -2, 3, 4, 5, 6])
+    assert tron.arr_to_buffer(floats) == array("d", [0.5, 1.5, 2.5])
+
+    out = bytearray(64)
+    assert tron.arr_to_buffer(floats, "d", out) == 3
+    assert array("d", out[:24]).tolist() == [0.5, 1.5, 2.5]
+    with pytest.raises(ValueError):
+        tron.arr_to_buffer(ints, "q", bytearray(8))
+    with pytest.raises(TypeError):
+        tron.arr_to_buffer(floats, "d", array("q", [0] * 3))
+
+
+def test_extend_and_export_errors():
+    tron = Tron(root="array")
+    with pytest.raises(TypeError):
+        tron.arr_extend_f64(array("q", [1]))
+    with pytest.raises(TypeError):
+        tron.arr_extend_i64([1, 2])
+    with pytest.raises(OverflowError):
+        tron.arr_extend_i64(array("Q", [1, 2**63]))
+    assert tron.to_obj() == []
+
+    tron.arr_extend_f64(array("d", [0.25]))
+    tron.arr_append_str("x")
+    with pytest.raises(TronError):
+        tron.arr_to_buffer(0, "q")
+    with pytest.raises(TronError):
+        tron.arr_to_buffer(0, "d")
+    with pytest.raises(ValueError):
+        tron.arr_to_buffer(0, "i")
+    with pytest.raises(TronError):
+        Tron().arr_extend_i64(array("q", [1]))
+
+
+def test_export_rereads_buffer_after_out_callback():
+    tron = Tron(root="array")
+    tron.arr_extend_i64(array("q", [1, 2, 3]))
+
+    class Growing(bytearray):
+        def __buffer__(self, flags):
+            for i in range(1000):
+                tron.arr_append_i64(i)
+            return super().__buffer__(flags)
+
+    with pytest.raises(RuntimeError):
+        tron.arr_to_buffer(0, "q", out=Growing(8 * 4000))
+    assert tron.to_obj()[:3] == [1, 2, 3]
+
+
+def test_export_rejects_a_tron_released_by_out_callback():
+    pool = Pool()
+    tron = pool.acquire(root="array")
+    tron.arr_extend_i64(array("q", [1, 2, 3]))
+
+    class Releasing(bytearray):
+        def __buffer__(self, flags):
+            pool.release(tron)
+            return super().__buffer__(flags)
+
+    with pytest.raises(ValueError):
+        tron.arr_to_buffer(0, "q", out=Releasing(8 * 3))
@@ -0,0 +1,60 @@
+import pytest
+
+from tron import Tron
+
+
+def test_memoryview_is_zero_copy_and_read_only():
+    tron = Tron()
+    tron.set_str("event", "lap_complete")
+
+    with memoryview(tron) as view:
+        assert view.readonly
+        assert view.nbytes == tron.buflen()
+        assert view.tobytes() == tron.to_bytes()
+        assert Tron.from_bytes(view).get_str("event") == "lap_complete"
+
+        with pytest.raises(BufferError):
+            tron.set_i64("lap", 55)
+        with pytest.raises(BufferError):
+            tron.arr_append_null()
+        with pytest.raises(BufferError):
+            tron.init_obj()
+
+    tron.set_i64("lap", 55)
+    assert tron.get_i64("lap") == 55
+
+
+def test_view_cannot_write_or_alias():
+    tron = Tron()
+    view = memoryview(tron)
+    with pytest.raises(TypeError):
+        view[0] = 0
+    view.release()
+
+    snapshot = tron.to_bytes()
+    tron.set_bytes("self", tron)
+    assert tron.get_bytes("self") == snapshot
+
+
+def test_failed_reinit_keeps_the_document():
+    tron = Tron()
+    tron.set_i64("lap", 55)
+    with memoryview(tron):
+        with pytest.raises(BufferError):
+            tron.__init__(root="array")
+    with pytest.raises(ValueError):
+        tron.__init__(root="table")
+    assert tron.get_i64("lap") == 55
+
+    tron.__init__(root="array")
+    assert tron.to_obj() == []
+
+    class Payload(bytes):
+        def __buffer__(self, flags):
+            with pytest.raises(BufferError, match="being modified"):
+                tron.__init__()
+            return super().__buffer__(flags)
+
+    tron.__init__()
+    tron.set_many({"blob": Payload(b"ok")})
+    assert tron.to_obj() == {"blob": b"ok"}
@@ -0,0 +1,161 @@
+from array import array
+
+import pytest
+
+from tron import Key, Tron, TronError
+
+
+def _items() -> Tron:
+    return Tron.from_obj(
+        {
+            "items": [
+                {"id": 1, "score": 0.5, "name": "alpha", "ok": True, "raw": b"\x01"},
+                {"id": 2, "score": 3, "name": "", "ok": False, "raw": b""},
+                {"id": 3, "score": 1.25, "name": "gamma", "ok": True, "raw": b"\x02\x03"},
+            ]
+        }
+    )
+
+
+def test_to_columns():
+    tron = _items()
+    cols = tron.to_columns(
+        tron.get_arr("items"), ["id", "score", Key("name"), "ok", "raw"], ["i64", "f64", "str", "bool", "bytes"]
+    )
+    assert cols["id"] == array("q", [1, 2, 3])
+    assert cols["score"] == array("d", [0.5, 3.0, 1.25])
+    assert cols["ok"] == array("b", [1, 0, 1])
+    offsets, data = cols["name"]
+    assert offsets == array("q", [0, 5, 5, 10]) and data == b"alphagamma"
+    assert cols["raw"] == (array("q", [0, 1, 1, 3]), b"\x01\x02\x03")
+
+    empty = Tron.from_obj({"items": []})
+    assert empty.to_columns(empty.get_arr("items"), ["id", "name"], ["i64", "str"]) == {
+        "id": array("q"),
+        "name": (array("q", [0]), b""),
+    }
+
+
+def test_to_columns_errors():
+    tron = _items()
+    items = tron.get_arr("items")
+    with pytest.raises(TronError, match="record 0: field 'missing'"):
+        tron.to_columns(items, ["missing"], ["i64"])
+    with pytest.raises(TronError, match="record 0: field 'score' is not i64"):
+        tron.to_columns(items, ["id", "score"], ["i64", "i64"])
+    with pytest.raises(ValueError):
+        tron.to_columns(items, ["id"], ["int"])
+    with pytest.raises(ValueError):
+        tron.to_columns(items, ["id", "name"], ["i64"])
+    with pytest.raises(TronError):
+        tron.to_columns(0, ["id"], ["i64"])
+    with pytest.raises(TronError, match="not an object"):
+        Tron.from_obj([1, 2]).to_columns(0, ["id"], ["i64"])
+
+
+def test_to_columns_rejects_an_array_that_changed(monkeypatch):
+    import array as array_module
+
+    tron = _items()
+    items = tron.get_arr("items")
+
+    def growing_array(*args):
+        tron.arr_append_obj(ofs=items)
+        return array(*args)
+
+    monkeypatch.setattr(array_module, "array", growing_array)
+    with pytest.raises(RuntimeError, match="changed size"):
+        tron.to_columns(items, ["id"], ["i64"])
+
+
+def test_from_columns_round_trip():
+    names = (array("q", [0, 5, 5, 10]), b"alphagamma")
+    cols = {
+        "id": array("q", [1, 2, 3]),
+        "score": array("d", [0.5, 3.0, 1.25]),
+        Key("name"): names,
+        "ok": memoryview(bytes([1, 0, 1])).cast("?"),
+        "tags": [["a"], [], None],
+    }
+    tron = Tron.from_columns(cols)
+    assert tron.to_obj() == [
+        {"id": 1, "score": 0.5, "name": "alpha", "ok": True, "tags": ["a"]},
+        {"id": 2, "score": 3.0, "name": "", "ok": False, "tags": []},
+        {"id": 3, "score": 1.25, "name": "gamma", "ok": True, "tags": None},
+    ]
+    back = tron.to_columns(0, ["id", "score", "name"], ["i64", "f64", "str"])
+    assert back == {"id": cols["id"], "score": cols["score"], "name": names}
+
+    doc = Tron.from_obj({"items": [{"id": 0}]})
+    items = doc.get_arr("items")
+    doc.extend_columns({"id": [7, 8]}, ofs=items)
+    assert doc.to_obj() == {"items": [{"id": 0}, {"id": 7}, {"id": 8}]}
+    assert Tron.from_columns({}).to_obj() == []
+
+
+def test_columns_round_trip_with_types():
+    tron = _items()
+    fields = ["id", "score", "name", "ok", "raw"]
+    kinds = ["i64", "f64", "str", "bool", "bytes"]
+    types = dict(zip(fields, kinds))
+    cols = tron.to_columns(tron.get_arr("items"), fields, kinds)
+
+    back = Tron.from_columns(cols, types=types)
+    assert back.to_obj() == [{**r, "score": float(r["score"])} for r in tron.to_obj()["items"]]
+    assert back.to_columns(0, fields, kinds) == cols
+
+    lists = Tron.from_columns(
+        {"ok": [True, False], "raw": [b"\x00", bytearray(b"")], "score": [1, 2.5]},
+        types={"ok": "bool", "raw": "bytes", "score": "f64"},
+    )
+    assert lists.to_obj() == [{"ok": True, "raw": b"\x00", "score": 1.0}, {"ok": False, "raw": b"", "score": 2.5}]
+    assert Tron.from_columns({"raw": (array("q", [0, 1]), b"\xff")}, types={"raw": "bytes"}).to_obj() == [
+        {"raw": b"\xff"}
+    ]
+
+
+def test_columns_types_errors():
+    with pytest.raises(ValueError, match="not in columns"):
+        Tron.from_columns({"a": [1]}, types={"b": "i64"})
+    with pytest.raises(ValueError):
+        Tron.from_columns({"a": [1]}, types={"a": "int"})
+    with pytest.raises(TypeError, match="expected bool"):
+        Tron.from_columns({"a": [True, 1]}, types={"a": "bool"})
+    with pytest.raises(TypeError):
+        Tron.from_columns({"a": array("d", [1.0])}, types={"a": "bool"})
+    with pytest.raises(TypeError):
+        Tron.from_columns({"a": array("q", [1])}, types={"a": "str"})
+
+
+def test_from_columns_errors():
+    with pytest.raises(ValueError, match="rows"):
+        Tron.from_columns({"a": [1, 2], "b": array("d", [1.0])})
+    with pytest.raises(TypeError):
+        Tron.from_columns({"a": 5})
+    with pytest.raises(TypeError):
+        Tron.from_columns({"a": memoryview(b"xy").cast("c")})
+    with pytest.raises(ValueError, match="offsets"):
+        Tron.from_columns({"a": (array("q", [0, 4, 2]), b"abcd")})
+    with pytest.raises(UnicodeDecodeError):
+        Tron.from_columns({"a": (array("q", [0, 1]), b"\xff")})
+    with pytest.raises(TronError):
+        Tron().extend_columns({"a": [1]})
+
+
+def test_extend_columns_rejects_bad_cells_before_writing():
+    doc = Tron.from_obj({"items": [{"id": 0}]})
+    items = doc.get_arr("items")
+    for cols, types in [
+        ({"id": [1, 2, object()]}, None),
+        ({"id": [1, 2, 1 << 70]}, None),
+        ({"id": [1, {"k": "\ud800"}]}, None),
+        ({"id": [1, 2, "3"]}, {"id": "i64"}),
+        ({"id": array("q", [1, 2]), "name": (array("q", [0, 1, 3]), b"ab\xc3")}, None),
+    ]:
+        with pytest.raises((TypeError, ValueError, OverflowError)):
+            doc.extend_columns(cols, ofs=items, types=types)
+        assert doc.to_obj() == {"items": [{"id": 0}]}
+
+    # Cells are UTF-8 one by one, so a character split across two of them is rejected.
+    with pytest.raises(UnicodeDecodeError):
+        Tron.from_columns({"a": (array("q", [0, 1, 2]), "é".encode())})
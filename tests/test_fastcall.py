@@ -0,0 +1,46 @@
+import pytest
+
+from tron import Key, Tron
+
+
+def test_positional_and_keyword_arguments():
+    tron = Tron()
+    items_ofs = tron.set_arr("items")
+    tron.arr_append_i64(1, items_ofs)
+    tron.arr_append_i64(value=2, ofs=items_ofs)
+    tron.set_i64(key="lap", value=55)
+    tron.set_f64("time_sec", 88)
+
+    assert tron.arr_get_i64(1, items_ofs) == 2
+    assert tron.arr_get_i64(index=0, ofs=items_ofs) == 1
+    assert tron.get_i64(ofs=0, key=Key("lap")) == 55
+    assert tron.get_f64("time_sec") == 88.0
+    assert tron.to_json(0, True) == tron.to_json(pretty=True)
+
+
+def test_argument_errors():
+    tron = Tron()
+    with pytest.raises(TypeError, match="missing required argument 'key'"):
+        tron.get_i64()
+    with pytest.raises(TypeError, match="unexpected keyword argument 'offset'"):
+        tron.get_i64("lap", offset=0)
+    with pytest.raises(TypeError, match="multiple values for argument 'key'"):
+        tron.get_i64("lap", key="lap")
+    with pytest.raises(TypeError, match="at most 2 arguments"):
+        tron.get_i64("lap", 0, 0)
+    with pytest.raises(TypeError):
+        tron.get_i64("lap", ofs=1.5)
+
+
+def test_construction():
+    assert Tron().to_obj() == {}
+    assert Tron("array").to_obj() == []
+    assert Tron(root="array", bufsz=4096).bufsz() >= 4096
+    with pytest.raises(ValueError):
+        Tron(root="tree")
+    with pytest.raises(TypeError):
+        Tron(rot="array")
+
+    tron = Tron()
+    tron.__init__("array")
+    assert tron.to_obj() == []
@@ -0,0 +1,112 @@
+import sys
+import sysconfig
+import threading
+
+import tron
+from tron import Tron
+
+THREADS = 8
+
+
+def _run_threads(target, count: int = THREADS) -> None:
+    barrier = threading.Barrier(count)
+
+    def run(index: int) -> None:
+        barrier.wait()
+        target(index)
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(count)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+
+def test_module_does_not_enable_gil():
+    assert tron.Tron is Tron
+    if sysconfig.get_config_var("Py_GIL_DISABLED"):
+        assert not sys._is_gil_enabled()
+
+
+def test_shared_tron_concurrent_writers_and_readers():
+    shared = Tron(bufsz=64)
+    errors = []
+
+    def work(index: int) -> None:
+        try:
+            for i in range(300):
+                shared.set_str(f"t{index}_{i % 16}", "v" * (i % 50))
+                shared.set_i64(f"n{index}", i)
+                assert shared.get_i64(f"n{index}") == i
+                shared.to_obj()
+        except Exception as exc:  # pragma: no cover - surfaced below
+            errors.append(exc)
+
+    _run_threads(work)
+    assert errors == []
+    assert {shared.get_i64(f"n{i}") for i in range(THREADS)} == {299}
+    assert len(shared) == THREADS * 17
+
+
+def test_views_and_arrays_under_contention():
+    shared = Tron.from_obj({"items": []})
+    items_ofs = shared.get_arr("items")
+
+    def work(index: int) -> None:
+        for i in range(200):
+            shared.arr_append_i64(index * 1000 + i, ofs=items_ofs)
+            try:
+                assert len(shared.view()["items"]) >= 1
+            except RuntimeError:
+                pass  # another thread appended between taking the view and reading it
+
+    _run_threads(work)
+    assert sorted(shared.to_obj()["items"]) == sorted(t * 1000 + i for t in range(THREADS) for i in range(200))
+
+
+def test_shared_iterator_over_frozen_tron():
+    frozen = Tron.from_obj({f"k{i}": i for i in range(4000)}).freeze()
+    it = iter(frozen)
+    seen = [[] for _ in range(THREADS)]
+
+    def work(index: int) -> None:
+        for key in it:
+            seen[index].append(key)
+
+    _run_threads(work)
+    keys = [key for chunk in seen for key in chunk]
+    assert sorted(keys) == sorted(f"k{i}" for i in range(4000))
+
+
+def test_keyword_arguments_from_many_threads():
+    def work(index: int) -> None:
+        doc = Tron(root="array", bufsz=64)
+        for i in range(100):
+            doc.arr_append_i64(value=i, ofs=0)
+        assert doc.to_obj() == list(range(100))
+
+    _run_threads(work)
+
+
+def test_caller_containers_mutated_by_other_threads():
+    keys = [f"k{i}" for i in range(32)]
+    payload = {"rows": [{"id": i} for i in range(32)]}
+    errors = []
+
+    def work(index: int) -> None:
+        try:
+            for i in range(200):
+                if index % 2:
+                    keys.append(keys.pop(0))
+                    payload["rows"].append(payload["rows"].pop(0))
+                    continue
+                local = Tron.from_obj(payload)
+                assert len(local.to_obj()["rows"]) in (31, 32)
+                local.set_many([(key, i) for key in keys[:4]])
+                assert len(local.get_many(keys)) in (31, 32)
+                tron.Path(keys[:3])
+        except Exception as exc:  # pragma: no cover - surfaced below
+            errors.append(exc)
+
+    _run_threads(work)
+    assert errors == []
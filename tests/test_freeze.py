@@ -0,0 +1,71 @@
+import threading
+
+import pytest
+
+from tron import FrozenTron, Tron, TronError
+
+
+def _config() -> Tron:
+    return Tron.from_obj({"routes": [{"path": "/a", "port": 80}, {"path": "/b", "port": 81}], "name": "edge"})
+
+
+def test_freeze_is_read_only_copy():
+    tron = _config()
+    frozen = tron.freeze()
+    assert isinstance(frozen, FrozenTron) and isinstance(frozen, Tron)
+    assert frozen.freeze() is frozen
+    assert frozen.to_obj() == tron.to_obj()
+    assert frozen.get_str("name") == "edge"
+    assert frozen.view()["routes"][1]["port"] == 81
+
+    with pytest.raises(TronError):
+        frozen.set_str("name", "other")
+    with pytest.raises(TronError):
+        frozen.set_many({"x": 1})
+    with pytest.raises(TronError):
+        frozen.__init__()
+
+    tron.set_str("name", "changed")
+    assert frozen.get_str("name") == "edge"
+
+
+def test_hash_and_bytewise_equality():
+    a = _config().freeze()
+    b = _config().freeze()
+    assert a == b and hash(a) == hash(b)
+    assert len({a, b}) == 1
+    assert bytes(a) == bytes(b)
+
+    other = _config()
+    other.set_i64("extra", 1)
+    c = other.freeze()
+    assert a != c
+    assert a != _config()
+
+
+def test_from_buffer_copies_writable_exporters():
+    data = bytearray(bytes(_config().freeze()))
+    frozen = FrozenTron.from_buffer(data)
+    before = hash(frozen)
+    data[:] = bytes(len(data))
+    data.extend(b"more")
+    assert frozen == _config().freeze() and hash(frozen) == before
+
+    borrowed = FrozenTron.from_buffer(bytes(_config().freeze()))
+    assert borrowed == frozen
+
+
+def test_concurrent_readers():
+    frozen = _config().freeze()
+    expected = frozen.to_obj()
+    results = []
+
+    def read():
+        results.append(all(frozen.to_obj() == expected and hash(frozen) for _ in range(200)))
+
+    threads = [threading.Thread(target=read) for _ in range(8)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert results == [True] * 8
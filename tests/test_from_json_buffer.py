@@ -0,0 +1,32 @@
+import json
+
+import pytest
+
+from tron import Tron, TronError
+
+DOC = {"user": {"id": 7, "name": "jdoé"}, "rows": list(range(100))}
+RAW = json.dumps(DOC, ensure_ascii=False).encode()
+
+
+def test_from_json_accepts_bytes_like():
+    assert Tron.from_json(RAW).to_obj() == DOC
+    assert Tron.from_json(bytearray(RAW)).to_obj() == DOC
+    assert Tron.from_json(memoryview(b"  " + RAW + b"  ")[2:-2]).to_obj() == DOC
+    assert Tron.from_json(RAW.decode()).to_obj() == DOC
+
+
+def test_from_json_rejects_non_buffers_and_bad_input():
+    with pytest.raises(TypeError):
+        Tron.from_json(123)
+    with pytest.raises(TronError):
+        Tron.from_json(b'{"a": ')
+
+
+def test_from_json_presizes_from_input_length(tmp_path):
+    big = json.dumps({"rows": [{"id": i, "name": f"row-{i}"} for i in range(5000)]}).encode()
+    tron = Tron.from_json(big)
+    assert tron.bufsz() >= len(big)
+
+    path = tmp_path / "big.json"
+    path.write_bytes(big)
+    assert Tron.from_json_file(str(path)).bufsz() >= len(big)
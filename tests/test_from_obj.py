@@ -0,0 +1,66 @@
+import pytest
+
+from tron import Tron, TronDocument, from_obj
+
+
+class Count(int):
+    pass
+
+
+def test_from_obj_round_trip():
+    payload = {
+        "user": {"id": 123, "name": "Jane", "score": 9.5},
+        "roles": ("admin", "editor"),
+        "active": True,
+        "missing": None,
+        "raw": bytearray(b"\x01\x02"),
+        "view": memoryview(b"xyz"),
+        "count": Count(3),
+        "nested": [[1, 2], {"a": []}],
+    }
+    tron = Tron.from_obj(payload, bufsz_hint=4096)
+    assert tron.bufsz() >= 4096
+    assert tron.get_i64("count") == 3
+    assert tron.to_obj() == {
+        "user": {"id": 123, "name": "Jane", "score": 9.5},
+        "roles": ["admin", "editor"],
+        "active": True,
+        "missing": None,
+        "raw": b"\x01\x02",
+        "view": b"xyz",
+        "count": 3,
+        "nested": [[1, 2], {"a": []}],
+    }
+    assert from_obj([1, "two"]).to_obj() == [1, "two"]
+    assert TronDocument.from_obj({"k": "v"}).to_obj() == {"k": "v"}
+
+
+def test_from_obj_errors():
+    with pytest.raises(TypeError):
+        Tron.from_obj("not a container")
+    with pytest.raises(TypeError):
+        Tron.from_obj({"bad": {1, 2}})
+    with pytest.raises(TypeError):
+        Tron.from_obj({1: "non-string key"})
+    with pytest.raises(OverflowError):
+        Tron.from_obj({"big": 1 << 64})
+
+    deep = []
+    for _ in range(100_000):
+        deep = [deep]
+    with pytest.raises(RecursionError):
+        Tron.from_obj(deep)
+
+
+def test_from_obj_survives_a_list_mutated_during_conversion():
+    items = []
+
+    class Clearing(bytes):
+        def __buffer__(self, flags):
+            items.clear()
+            return super().__buffer__(flags)
+
+    items.extend([Clearing(b"ab"), *(str(i) * 64 for i in range(32))])
+    result = Tron.from_obj({"items": items}).to_obj()["items"]
+    assert result[0] == b"ab"
+    assert all(isinstance(value, str) for value in result[1:])
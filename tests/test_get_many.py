@@ -0,0 +1,37 @@
+import pytest
+
+from tron import Key, Path, Tron, TronError
+
+
+def make_event():
+    return Tron.from_obj({"id": 7, "name": "lap", "meta": {"zone": "eu", "ids": [10, 20]}})
+
+
+def test_get_many():
+    tron = make_event()
+    assert tron.get_many(["id", Key("name"), "missing"]) == (7, "lap", None)
+    assert tron.get_many(("id", "missing"), default=-1) == (7, -1)
+    assert tron.get_many(["id", Key("name")], as_dict=True) == {"id": 7, "name": "lap"}
+
+    meta_ofs = tron.get_obj("meta")
+    assert tron.get_many(["zone", "ids"], ofs=meta_ofs) == ("eu", tron.get_arr("ids", ofs=meta_ofs))
+
+    with pytest.raises(TypeError):
+        tron.get_many(["id", 3])
+    for lone in ("id", b"id", bytearray(b"id")):
+        with pytest.raises(TypeError, match="sequence"):
+            tron.get_many(lone)
+    with pytest.raises(TronError):
+        tron.get_many(["id"], ofs=tron.get_arr("ids", ofs=meta_ofs))
+
+
+def test_extract():
+    tron = make_event()
+    spec = [Path("meta.ids[1]"), "meta.zone", "id", "meta.ids[9]", "meta.nope.deeper"]
+    assert tron.extract(spec) == (20, "eu", 7, None, None)
+    assert tron.extract(["meta.ids[9]"], default=0) == (0,)
+
+    with pytest.raises(TronError):
+        tron.extract(["name.first"])
+    with pytest.raises(ValueError):
+        tron.extract(["meta..zone"])
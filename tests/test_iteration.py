@@ -0,0 +1,59 @@
+import pytest
+
+from tron import Key, Path, Tron, TronDocument, TronError
+
+
+def test_object_iteration():
+    tron = Tron.from_obj({"id": 7, "name": "lap", "meta": {"zone": "eu"}, "ids": [1, 2, 3]})
+    meta_ofs = tron.get_obj("meta")
+    ids_ofs = tron.get_arr("ids")
+
+    assert sorted(tron.keys()) == ["id", "ids", "meta", "name"]
+    assert sorted(tron) == sorted(tron.keys())
+    assert dict(tron.items())["meta"] == meta_ofs
+    assert list(tron.items(ofs=meta_ofs)) == [("zone", "eu")]
+    assert list(tron.values(ids_ofs)) == [1, 2, 3]
+    assert len(tron) == tron.count() == 4
+    assert tron.count(ids_ofs) == 3
+
+    assert tron["name"] == "lap"
+    assert tron[Key("id")] == 7
+    assert tron[Path("meta.zone")] == "eu"
+    assert "name" in tron and "nope" not in tron
+    assert Key("meta") in tron and 7 not in tron and Path("meta.zone") not in tron
+    with pytest.raises(KeyError):
+        tron["nope"]
+    with pytest.raises(TypeError):
+        tron[0]
+    with pytest.raises(TronError):
+        tron.keys(ids_ofs)
+
+
+def test_array_sequence_protocol():
+    tron = Tron.from_obj([10, "x", None, [1]])
+    assert len(tron) == 4
+    assert list(tron) == [10, "x", None, tron[3]]
+    assert tron[-3] == "x"
+    assert tron.to_obj(ofs=tron[-1]) == [1]
+    with pytest.raises(IndexError):
+        tron[4]
+
+    assert "x" in tron and 10 in tron and "y" not in tron
+
+    doc = TronDocument.from_obj(["a", "b"])
+    assert len(doc) == 2 and list(doc) == ["a", "b"] and doc[1] == "b" and "b" in doc
+    assert not Tron() and not Tron(root="array") and Tron.from_obj({"a": 1})
+
+
+def test_mutation_during_iteration():
+    tron = Tron.from_obj({"a": 1, "b": 2})
+    it = tron.keys()
+    next(it)
+    tron.set_i64("c", 3)
+    with pytest.raises(RuntimeError):
+        next(it)
+    with pytest.raises(StopIteration):
+        next(it)
+
+    assert len(Tron()) == 0
+    assert list(Tron().items()) == []
@@ -0,0 +1,84 @@
+import io
+import json
+import os
+
+import pytest
+
+from tron import Tron, TronError
+
+DOC = {"name": "jdoe", "tags": ["a", "é", "日本"], "nested": {"n": 1.5, "ok": True, "none": None}}
+
+
+def test_to_json_bytes_matches_to_json():
+    tron = Tron.from_obj(DOC)
+    data = tron.to_json_bytes()
+    assert isinstance(data, bytes)
+    assert data == tron.to_json().encode()
+    assert json.loads(tron.to_json_bytes(pretty=True)) == DOC
+    nested_ofs = tron.get_obj("nested")
+    assert json.loads(tron.to_json_bytes(ofs=nested_ofs)) == DOC["nested"]
+
+
+def test_to_json_into():
+    tron = Tron.from_obj(DOC)
+    expected = tron.to_json_bytes()
+    buf = bytearray(len(expected) + 1)
+    n = tron.to_json_into(buf)
+    assert n == len(expected) and bytes(buf[:n]) == expected
+
+    big = bytearray(4096)
+    n = tron.to_json_into(memoryview(big)[100:])
+    assert bytes(big[100 : 100 + n]) == expected
+
+    with pytest.raises(TronError):
+        tron.to_json_into(bytearray(8))
+    with pytest.raises(BufferError):
+        tron.to_json_into(b"readonly" * 100)
+
+
+def test_dump_json_write_results():
+    tron = Tron.from_obj({"rows": list(range(500))})
+    expected = tron.to_json_bytes()
+
+    class Short(io.BytesIO):
+        def write(self, b):
+            return super().write(bytes(b)[:7])
+
+    out = Short()
+    assert tron.dump_json(out, chunk_size=100) == len(expected)
+    assert out.getvalue() == expected
+
+    class Blocking:
+        def write(self, b):
+            return None
+
+    with pytest.raises(BlockingIOError):
+        tron.dump_json(Blocking())
+
+    class Liar:
+        def write(self, b):
+            return len(b) + 1
+
+    with pytest.raises(OSError, match="returned"):
+        tron.dump_json(Liar())
+
+
+def test_dump_json_fileobj_and_fd(tmp_path):
+    tron = Tron.from_obj({"rows": list(range(5000))})
+    expected = tron.to_json_bytes()
+
+    out = io.BytesIO()
+    assert tron.dump_json(out, chunk_size=1000) == len(expected)
+    assert out.getvalue() == expected
+
+    path = tmp_path / "doc.json"
+    fd = os.open(path, os.O_WRONLY | os.O_CREAT | os.O_TRUNC)
+    try:
+        assert tron.dump_json(fd, chunk_size=4096) == len(expected)
+    finally:
+        os.close(fd)
+    assert path.read_bytes() == expected
+
+    with open(path, "wb") as fp:
+        tron.dump_json(fp, pretty=True)
+    assert json.loads(path.read_bytes()) == {"rows": list(range(5000))}
@@ -0,0 +1,47 @@
+import pytest
+
+from tron import DJB2_HASH_SEED, Key, Tron, TronError
+
+
+def djb2(name):
+    h = DJB2_HASH_SEED
+    for byte in name.encode():
+        h = (h * 33 + byte) & 0xFFFFFFFF
+    return h
+
+
+def test_key_is_interchangeable_with_str():
+    user_id = Key("user_id")
+    assert user_id.name == "user_id"
+    assert str(user_id) == "user_id"
+    assert repr(user_id) == "Key('user_id')"
+    assert user_id.hash == djb2("user_id")
+
+    tron = Tron()
+    tron.set_i64(user_id, 7)
+    assert tron.get_i64("user_id") == 7
+    tron.set_str("name", "jdoe")
+    assert tron.get_str(Key("name")) == "jdoe"
+
+    meta = Key("meta")
+    meta_ofs = tron.set_obj(meta)
+    assert tron.get_obj(meta) == meta_ofs
+    tron.set_f64(Key("score"), 1.5, ofs=meta_ofs)
+    assert tron.get(Key("score"), ofs=meta_ofs) == 1.5
+    assert tron.get_type(user_id) == "i64"
+    assert tron.exists(user_id)
+    assert not tron.exists(Key("missing"))
+    assert tron.to_obj() == {"user_id": 7, "name": "jdoe", "meta": {"score": 1.5}}
+
+
+def test_key_validation():
+    with pytest.raises(TypeError):
+        Key(b"raw")
+    with pytest.raises(ValueError):
+        Key("a\0b")
+
+    tron = Tron()
+    with pytest.raises(TypeError):
+        tron.set_i64(1, 2)
+    with pytest.raises(TronError):
+        tron.get_i64(Key("missing"))
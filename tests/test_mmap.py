@@ -0,0 +1,47 @@
+import pytest
+
+from tron import Tron, TronError
+
+
+def _snapshot(path):
+    tron = Tron()
+    tron.set_str("name", "snapshot")
+    items_ofs = tron.set_arr("items")
+    tron.arr_append_i64(42, ofs=items_ofs)
+    tron.save(str(path))
+    return tron.to_bytes()
+
+
+def test_open_mmap_reads_without_copy(tmp_path):
+    path = tmp_path / "snapshot.tron"
+    raw = _snapshot(path)
+
+    tron = Tron.open_mmap(str(path))
+    assert tron.buflen() == len(raw)
+    assert tron.get_str("name") == "snapshot"
+    assert tron.arr_get_i64(0, ofs=tron.get_arr("items")) == 42
+    assert bytes(memoryview(tron)) == raw
+
+    with pytest.raises(TronError):
+        tron.set_i64("extra", 1)
+    assert tron.get_str("name") == "snapshot"
+
+
+def test_open_mmap_copy_on_write(tmp_path):
+    path = tmp_path / "snapshot.tron"
+    raw = _snapshot(path)
+
+    tron = Tron.open_mmap(str(path), copy_on_write=True)
+    tron.set_i64("extra", 1)
+    assert tron.get_i64("extra") == 1
+    assert tron.get_str("name") == "snapshot"
+    assert path.read_bytes() == raw
+
+
+def test_open_mmap_errors(tmp_path):
+    empty = tmp_path / "empty.tron"
+    empty.write_bytes(b"")
+    with pytest.raises(TronError):
+        Tron.open_mmap(str(empty))
+    with pytest.raises(TronError):
+        Tron.open_mmap(str(tmp_path / "missing.tron"))
@@ -0,0 +1,79 @@
+import io
+import json
+
+import pytest
+
+from tron import StreamReader, Tron, TronError, iter_ndjson, ndjson_to_stream
+
+ROWS = [{"seq": i, "name": f"row-{i}", "tags": ["x"] * (i % 4)} for i in range(200)]
+NDJSON = "".join(json.dumps(row) + ("\r\n" if i % 3 == 0 else "\n") for i, row in enumerate(ROWS)).encode()
+
+
+def test_iter_ndjson_path_and_fileobj(tmp_path):
+    path = tmp_path / "rows.ndjson"
+    path.write_bytes(NDJSON + b"\n   \n")
+
+    assert [t.to_obj() for t in iter_ndjson(path)] == ROWS
+    assert [t.to_obj() for t in iter_ndjson(str(path), chunk_size=16)] == ROWS
+    assert [t.to_obj() for t in iter_ndjson(io.BytesIO(NDJSON.rstrip(b"\n")), chunk_size=7)] == ROWS
+    assert all(type(t) is Tron for t in iter_ndjson(io.BytesIO(NDJSON)))
+
+
+def test_reuse_yields_one_tron():
+    seen = []
+    for tron in iter_ndjson(io.BytesIO(NDJSON), reuse=True):
+        seen.append((id(tron), tron.get_i64("seq")))
+    assert len({ident for ident, _ in seen}) == 1
+    assert [seq for _, seq in seen] == list(range(200))
+
+
+def test_ndjson_to_stream():
+    out = io.BytesIO()
+    assert ndjson_to_stream(io.BytesIO(NDJSON), out, chunk_size=64) == len(ROWS)
+    assert [r.to_obj() for r in StreamReader(out.getvalue())] == ROWS
+
+
+def test_bad_line_reports_line_number():
+    with pytest.raises(TronError, match="line 2"):
+        list(iter_ndjson(io.BytesIO(b'{"a": 1}\n{"a": \n')))
+    with pytest.raises(TypeError):
+        iter_ndjson(123)
+
+
+def test_readinto_that_keeps_the_view_ends_iteration():
+    class Hoarder(io.BytesIO):
+        def readinto(self, view):
+            self.kept = memoryview(view)
+            return super().readinto(view)
+
+    it = iter_ndjson(Hoarder(NDJSON), chunk_size=8)
+    with pytest.raises(BufferError):
+        next(it)
+    with pytest.raises(StopIteration):
+        next(it)
+
+
+def test_readinto_none_is_not_end_of_file():
+    class NotReady(io.BytesIO):
+        ready = False
+
+        def readinto(self, view):
+            return super().readinto(view) if self.ready else None
+
+    source = NotReady(NDJSON)
+    it = iter_ndjson(source)
+    with pytest.raises(BlockingIOError):
+        next(it)
+    source.ready = True
+    assert [t.to_obj() for t in it] == ROWS
+
+
+def test_reentrant_next_is_rejected():
+    class Reentrant(io.BytesIO):
+        def readinto(self, view):
+            with pytest.raises(ValueError, match="already executing"):
+                next(it)
+            return super().readinto(view)
+
+    it = iter_ndjson(Reentrant(NDJSON))
+    assert [t.to_obj() for t in it] == ROWS
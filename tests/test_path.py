@@ -0,0 +1,58 @@
+import pytest
+
+from tron import Key, Path, Tron, TronError
+
+
+def make_request():
+    return Tron.from_obj(
+        {
+            "route": {"service": "auth", "hops": [{"host": "a"}, {"host": "b", "port": 8443}]},
+            "matrix": [[1, 2], [3, 4]],
+        }
+    )
+
+
+def test_get_path():
+    tron = make_request()
+    assert tron.get_path("route.service") == "auth"
+    assert tron.get_path("route.hops[1].port") == 8443
+    assert tron.get_path(Path("matrix[1][0]")) == 3
+    assert tron.get_path(("route", Key("hops"), 0, "host")) == "a"
+
+    hops_ofs = tron.get_path("route.hops")
+    assert hops_ofs == tron.get_arr("hops", ofs=tron.get_obj("route"))
+    assert tron.get_path("[1].host", ofs=hops_ofs) == "b"
+
+    with pytest.raises(TronError, match="segment 2"):
+        tron.get_path("route.hops[5].host")
+    with pytest.raises(TronError, match="segment 2"):
+        tron.get_path("route.service.name")
+
+
+def test_set_path_creates_objects():
+    tron = make_request()
+    tron.set_path("route.hops[0].port", 80)
+    tron.set_path(Path("meta.trace.id"), "t-1")
+    tron.set_path("meta.tags", ["x", {"y": None}])
+
+    obj = tron.to_obj()
+    assert obj["route"]["hops"][0] == {"host": "a", "port": 80}
+    assert obj["meta"] == {"trace": {"id": "t-1"}, "tags": ["x", {"y": None}]}
+
+    with pytest.raises(ValueError):
+        tron.set_path("matrix[0]", 1)
+    with pytest.raises(TronError):
+        tron.set_path("matrix[7].x", 1)
+
+
+def test_path_compile():
+    path = Path("a.b[3].c")
+    assert path.segments == ("a", "b", 3, "c")
+    assert repr(path) == "Path('a.b[3].c')"
+    assert Path(["a.b", 0]).segments == ("a.b", 0)
+
+    for bad in ("", "a..b", "a.", "a[x]", "a[1", "a]b", "a[1]b", ".a"):
+        with pytest.raises(ValueError):
+            Path(bad)
+    with pytest.raises(TypeError):
+        Path(42)
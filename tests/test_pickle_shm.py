@@ -0,0 +1,73 @@
+import copy
+import pickle
+from multiprocessing import shared_memory
+
+import pytest
+
+from tron import FrozenTron, Tron, TronError
+
+
+def _doc() -> Tron:
+    return Tron.from_obj({"id": 7, "tags": ["a", "b"], "blob": b"\x00\x01"})
+
+
+@pytest.mark.parametrize("protocol", range(2, pickle.HIGHEST_PROTOCOL + 1))
+def test_pickle_round_trip(protocol):
+    tron = _doc()
+    clone = pickle.loads(pickle.dumps(tron, protocol=protocol))
+    assert type(clone) is Tron and clone.to_obj() == tron.to_obj()
+    clone.set_i64("id", 8)
+    assert tron.get_i64("id") == 7
+
+    frozen = pickle.loads(pickle.dumps(tron.freeze(), protocol=protocol))
+    assert isinstance(frozen, FrozenTron) and frozen == tron.freeze()
+    assert copy.deepcopy(tron).to_obj() == tron.to_obj()
+
+
+def test_pickle_out_of_band():
+    frozen = _doc().freeze()
+    buffers = []
+    data = pickle.dumps(frozen, protocol=5, buffer_callback=buffers.append)
+    assert len(buffers) == 1 and len(data) < 100
+    assert buffers[0].raw().nbytes == frozen.buflen()
+
+    clone = pickle.loads(data, buffers=buffers)
+    assert clone == frozen
+    with pytest.raises(pickle.UnpicklingError):
+        pickle.loads(data)
+
+
+def test_shared_memory_round_trip():
+    tron = _doc()
+    shm = tron.to_shared_memory()
+    try:
+        peer = shared_memory.SharedMemory(name=shm.name)
+        frozen = Tron.from_shared_memory(peer)
+        assert isinstance(frozen, FrozenTron)
+        assert frozen.to_obj() == tron.to_obj() and frozen.buflen() == tron.buflen()
+
+        private = Tron.from_shared_memory(peer, readonly=False)
+        private.set_i64("id", 9)
+        assert frozen.get_i64("id") == 7
+        del frozen
+        peer.close()
+
+        with pytest.raises(TronError):
+            Tron.from_shared_memory(bytearray(16))
+    finally:
+        shm.close()
+        shm.unlink()
+
+
+def test_to_shared_memory_rejects_a_tron_that_changed(monkeypatch):
+    tron = _doc()
+
+    class Growing(shared_memory.SharedMemory):
+        def __init__(self, *args, **kwargs):
+            super().__init__(*args, **kwargs)
+            tron.set_str("pad", "x" * 4096)
+
+    monkeypatch.setattr(shared_memory, "SharedMemory", Growing)
+    with pytest.raises(RuntimeError, match="changed size"):
+        tron.to_shared_memory()
+    assert tron.get_str("pad") == "x" * 4096
@@ -0,0 +1,77 @@
+import gc
+
+import pytest
+
+from tron import Pool, Tron
+
+
+def test_pool_reuses_released_buffers():
+    pool = Pool(bufsz=4096, max_idle=2)
+    assert (pool.bufsz, pool.max_idle, pool.idle) == (4096, 2, 0)
+
+    with pool.acquire() as tron:
+        assert isinstance(tron, Tron)
+        tron.set_str("k", "v")
+        assert tron.to_obj() == {"k": "v"}
+    assert pool.idle == 1
+    with pytest.raises(ValueError):
+        tron.get_str("k")
+    with pytest.raises(ValueError):
+        memoryview(tron)
+
+    again = pool.acquire(root="array")
+    assert pool.idle == 0
+    assert again.to_obj() == []
+    pool.release(again)
+    pool.release(again)
+    assert pool.idle == 1
+
+    extra = [pool.acquire() for _ in range(4)]
+    del extra
+    gc.collect()
+    assert pool.idle == 2
+
+
+def test_pool_release_checks():
+    pool = Pool()
+    tron = pool.acquire()
+    with memoryview(tron):
+        with pytest.raises(BufferError):
+            pool.release(tron)
+    with pytest.raises(ValueError):
+        Pool().release(tron)
+    with pytest.raises(TypeError):
+        pool.release(object())
+    pool.release(tron)
+
+    with Tron() as plain:
+        plain.set_i64("a", 1)
+    assert plain.get_i64("a") == 1
+
+
+def test_release_during_own_write_is_refused():
+    pool = Pool()
+    tron = pool.acquire()
+
+    class Payload(bytes):
+        def __buffer__(self, flags):
+            with pytest.raises(BufferError, match="being modified"):
+                pool.release(tron)
+            return super().__buffer__(flags)
+
+    tron.set_many({"blob": Payload(b"xyz")})
+    assert tron.get_bytes("blob") == b"xyz"
+    pool.release(tron)
+    assert pool.idle == 1
+
+
+def test_reset_keeps_capacity():
+    tron = Tron()
+    for i in range(200):
+        tron.set_str(f"key{i}", "x" * 32)
+    bufsz = tron.bufsz()
+    tron.reset(root="array")
+    assert tron.to_obj() == []
+    assert tron.bufsz() == bufsz
+    tron.reset()
+    assert tron.to_obj() == {}
@@ -0,0 +1,73 @@
+import gc
+
+import pytest
+
+from tron import Path, Predicate, Tron, TronError
+
+
+def _users() -> Tron:
+    return Tron.from_obj(
+        {
+            "users": [
+                {"name": "ann", "status": "active", "score": 0.95, "age": 31, "admin": True, "meta": {"team": "a"}},
+                {"name": "bob", "status": "idle", "score": 0.99, "age": 45, "admin": False, "meta": {"team": "b"}},
+                {"name": "cy", "status": "active", "score": 0.5, "age": 22, "admin": False, "meta": None},
+                {"name": "dee", "status": "active", "score": 1, "age": 38, "admin": True, "meta": {"team": "a"}},
+                "not-a-record",
+            ]
+        }
+    )
+
+
+def test_select_filters_in_c():
+    tron = _users()
+    users = tron.get_arr("users")
+    where = Predicate(("and", ("==", "status", "active"), (">", "score", 0.9)))
+    assert repr(where).startswith("Predicate(('and'")
+    assert tron.select(users, where=where) == [0, 3]
+    assert tron.select(users, where=("or", ("<", "age", 25), ("==", "admin", True))) == [0, 2, 3]
+    assert tron.select(users, where=("not", ("==", "status", "active"))) == [1, 4]
+    assert tron.select(users, where=("==", Path("meta.team"), "a")) == [0, 3]
+    assert tron.select(users, where=("==", "meta", None)) == [2]
+    assert tron.select(users, where=(">=", "name", "bob")) == [1, 2, 3]
+    assert tron.select(users) == [0, 1, 2, 3, 4]
+
+    offsets = tron.select(users, where=where, offsets=True)
+    assert [tron.get_str("name", ofs) for ofs in offsets] == ["ann", "dee"]
+    assert tron.select(users, where=where, project=["name", "age", "meta.team", "missing"]) == [
+        ("ann", 31, "a", None),
+        ("dee", 38, "a", None),
+    ]
+
+
+def test_predicate_errors():
+    with pytest.raises(ValueError):
+        Predicate(("~", "a", 1))
+    with pytest.raises(ValueError):
+        Predicate(("<", "a", None))
+    with pytest.raises(ValueError):
+        Predicate(("not", ("==", "a", 1), ("==", "b", 2)))
+    with pytest.raises(TypeError):
+        Predicate(("==", "a", [1]))
+    with pytest.raises(TypeError):
+        Predicate("a > 1")
+    nested = ("==", "a", 1)
+    for _ in range(40):
+        nested = ("not", nested)
+    with pytest.raises(ValueError):
+        Predicate(nested)
+    with pytest.raises(TronError):
+        Tron().select(0)
+    with pytest.raises(ValueError, match="not both"):
+        _users().select(0, project=["name"], offsets=True)
+
+
+def test_predicate_cycles_are_collected():
+    spec = ["==", "name", "ann"]
+    where = Predicate(spec)
+    spec.append(where)  # spec -> predicate -> spec
+    assert gc.is_tracked(where) and spec in gc.get_referents(where)
+    tron = _users()
+    assert tron.select(tron.get_arr("users"), where=where) == [0]
+    del spec, where
+    assert gc.collect() >= 2
@@ -0,0 +1,66 @@
+from types import MappingProxyType
+
+import pytest
+
+from tron import Key, Tron, TronDocument
+
+
+def test_set_many_dict_and_pairs():
+    tron = Tron()
+    tron.set_many({"id": 7, "name": "lap", "tags": ["a", "b"], "meta": {"zone": "eu"}, "raw": b"\x00"})
+    meta_ofs = tron.get_obj("meta")
+    tron.set_many([("zone", "us"), (Key("ok"), True), ["none", None]], ofs=meta_ofs)
+    tron.set_many((("gen", i) for i in range(3)))
+
+    assert tron.to_obj() == {
+        "id": 7,
+        "name": "lap",
+        "tags": ["a", "b"],
+        "meta": {"zone": "us", "ok": True, "none": None},
+        "raw": b"\x00",
+        "gen": 2,
+    }
+
+
+def test_set_many_grows_large_batches():
+    tron = Tron()
+    fields = {f"field_{i}": "x" * 200 for i in range(64)}
+    tron.set_many(fields)
+    assert tron.bufsz() >= tron.buflen()
+    assert tron.to_obj() == fields
+
+    doc = TronDocument()
+    doc.set_value_map({"a": 1.5, "b": bytearray(b"ab")})
+    assert doc.to_obj() == {"a": 1.5, "b": b"ab"}
+    doc.set_value_map(MappingProxyType({"c": [1]}))
+    assert doc.to_obj() == {"a": 1.5, "b": b"ab", "c": [1]}
+
+
+def test_set_many_errors():
+    tron = Tron()
+    with pytest.raises(TypeError):
+        tron.set_many([("a", 1), "b"])
+    with pytest.raises(ValueError):
+        tron.set_many([("a", 1, 2)])
+    with pytest.raises(TypeError):
+        tron.set_many({1: "x"})
+    with pytest.raises(TypeError):
+        tron.set_many({"a": object()})
+    with memoryview(tron):
+        with pytest.raises(BufferError):
+            tron.set_many({"a": 1})
+
+
+def test_set_many_keeps_its_copy_of_a_dict_mutated_during_the_write():
+    items = {}
+
+    class Clearing(bytes):
+        def __buffer__(self, flags):
+            items.clear()
+            return super().__buffer__(flags)
+
+    items.update({"a": Clearing(b"x"), "b": 2, "c": "three"})
+    tron = Tron()
+    tron.set_many(items)
+    assert items == {}
+    assert tron.to_obj() == {"a": b"x", "b": 2, "c": "three"}
@@ -0,0 +1,65 @@
+import io
+import mmap
+
+import pytest
+
+from tron import FrozenTron, StreamReader, StreamWriter, Tron, TronError
+
+
+def _events(n: int) -> list[Tron]:
+    return [Tron.from_obj({"seq": i, "event": "lap" * (i % 5), "ok": i % 2 == 0}) for i in range(n)]
+
+
+def test_roundtrip_path_is_zero_copy(tmp_path):
+    path = tmp_path / "events.tronstream"
+    with open(path, "wb") as fp, StreamWriter(fp, buffer_size=64) as writer:
+        writer.write(_events(1)[0])
+        writer.write_many(_events(50)[1:])
+        assert writer.count == 50
+
+    with StreamReader(path) as reader:
+        records = list(reader)
+    assert [r.get_i64("seq") for r in records] == list(range(50))
+    assert all(isinstance(r, FrozenTron) for r in records)
+    assert records[7].to_obj() == _events(8)[7].to_obj()
+
+
+def test_append_and_file_object_reader(tmp_path):
+    path = tmp_path / "events.tronstream"
+    with open(path, "wb") as fp:
+        StreamWriter(fp).write_many(_events(3))
+    with open(path, "ab") as fp:
+        StreamWriter(fp).write_many(_events(5)[3:])
+
+    with open(path, "rb") as fp:
+        records = list(StreamReader(fp))
+    assert [r.get_i64("seq") for r in records] == list(range(5))
+    assert not isinstance(records[0], FrozenTron)
+    records[0].set_i64("seq", 99)
+
+
+def test_mmap_and_buffer_sources():
+    out = io.BytesIO()
+    StreamWriter(out).write_many(_events(4))
+    data = out.getvalue()
+
+    assert [r.get_i64("seq") for r in StreamReader(data)] == [0, 1, 2, 3]
+    copies = list(StreamReader(data, copy=True))
+    assert type(copies[0]) is Tron
+
+    with mmap.mmap(-1, len(data)) as mm:
+        mm.write(data)
+        record = next(iter(StreamReader(mm)))
+        assert record.get_i64("seq") == 0
+        del record
+
+
+def test_corrupt_streams():
+    with pytest.raises(TronError):
+        list(StreamReader(b"NOTTRON!" + bytes(8)))
+    out = io.BytesIO()
+    StreamWriter(out).write_many(_events(2))
+    with pytest.raises(TronError):
+        list(StreamReader(out.getvalue()[:-9]))
+    with pytest.raises(ValueError):
+        FrozenTron.from_buffer(bytes(16), 3, 8)
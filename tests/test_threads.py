@@ -0,0 +1,68 @@
+import json
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+
+from tron import Tron
+
+
+def test_concurrent_decode_encode():
+    payloads = [json.dumps({"seed": seed, "rows": list(range(500))}) for seed in range(8)]
+
+    def roundtrip(payload: str) -> dict:
+        return json.loads(Tron.from_json(payload).to_json())
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        results = list(pool.map(roundtrip, payloads * 4))
+    assert results == [json.loads(p) for p in payloads * 4]
+
+
+def test_mutation_waits_for_gil_free_readers(tmp_path):
+    tron = Tron.from_obj({"rows": list(range(2000))})
+
+    def writer():
+        for i in range(2000):
+            tron.set_i64(f"k{i % 64}", i)
+
+    thread = threading.Thread(target=writer)
+    thread.start()
+    try:
+        for i in range(50):
+            json.loads(tron.to_json())
+            tron.save(str(tmp_path / "doc.lite3"))
+            assert Tron.from_file(str(tmp_path / "doc.lite3")).get_arr("rows") >= 0
+    finally:
+        thread.join()
+    assert tron.get_i64(f"k{1999 % 64}") == 1999
+
+
+def test_write_callback_may_reenter_same_tron():
+    tron = Tron()
+    seen = {}
+
+    class Payload(bytes):
+        def __buffer__(self, flags):
+            seen["json"] = tron.to_json()
+            with pytest.raises(BufferError):
+                memoryview(tron)
+            return super().__buffer__(flags)
+
+    tron.set_many({"blob": Payload(b"xyz")})
+    assert json.loads(seen["json"]) == {}
+    assert tron.get_bytes("blob") == b"xyz"
+    with memoryview(tron) as view:
+        assert len(view) == tron.buflen()
+
+
+def test_from_columns_leaves_the_new_tron_unlocked():
+    tron = Tron.from_columns({"id": [1, 2]})
+
+    def writer():
+        tron.arr_append_null()
+
+    thread = threading.Thread(target=writer)
+    thread.start()
+    thread.join(timeout=10)
+    assert not thread.is_alive()
+    assert tron.to_obj() == [{"id": 1}, {"id": 2}, None]
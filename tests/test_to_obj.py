@@ -0,0 +1,41 @@
+import json
+
+from tron import Tron, TronDocument, to_obj
+
+
+def test_to_obj_nested():
+    tron = Tron()
+    tron.set_str("name", "jdoe")
+    tron.set_i64("id", 7)
+    tron.set_f64("score", 1.5)
+    tron.set_bool("active", True)
+    tron.set_null("notes")
+    tron.set_bytes("blob", b"\x00\xffraw")
+
+    tags_ofs = tron.set_arr("tags")
+    tron.arr_append_str("a", ofs=tags_ofs)
+    tron.arr_append_i64(2, ofs=tags_ofs)
+    inner_ofs = tron.arr_append_obj(ofs=tags_ofs)
+    tron.set_str("k", "v", ofs=inner_ofs)
+
+    expected = {
+        "name": "jdoe",
+        "id": 7,
+        "score": 1.5,
+        "active": True,
+        "notes": None,
+        "blob": b"\x00\xffraw",
+        "tags": ["a", 2, {"k": "v"}],
+    }
+    assert tron.to_obj() == expected
+    assert to_obj(tron) == expected
+    assert tron.to_obj(ofs=tags_ofs) == ["a", 2, {"k": "v"}]
+
+
+def test_to_obj_matches_json():
+    payload = {"user": {"id": 1, "roles": ["admin", "editor"]}, "empty": {}, "list": []}
+    tron = Tron.from_json(json.dumps(payload))
+    assert tron.to_obj() == json.loads(tron.to_json()) == payload
+
+    doc = TronDocument.from_obj([1, [2, [3]], {"x": None}])
+    assert doc.to_obj() == [1, [2, [3]], {"x": None}]
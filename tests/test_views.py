@@ -0,0 +1,62 @@
+from collections.abc import Mapping, Sequence
+
+import pytest
+
+from tron import Tron, TronDict, TronError, TronList
+
+
+def _sample() -> Tron:
+    return Tron.from_obj({"user": {"id": 7, "roles": ["admin", "editor", "admin"]}, "n": 1.5})
+
+
+def test_dict_view_mapping():
+    view = _sample().view()
+    assert isinstance(view, TronDict) and isinstance(view, Mapping)
+    assert len(view) == 2
+    assert "user" in view and "missing" not in view and 3 not in view
+    assert view["n"] == 1.5
+    assert view.get("missing", 0) == 0
+    assert sorted(view.keys()) == ["n", "user"]
+    assert dict(view.items())["n"] == 1.5
+    with pytest.raises(KeyError):
+        view["missing"]
+
+
+def test_nested_views_and_list_sequence():
+    tron = _sample()
+    roles = tron.view()["user"]["roles"]
+    assert isinstance(roles, TronList) and isinstance(roles, Sequence)
+    assert roles[0] == "admin" and roles[-1] == "admin"
+    assert roles[1:] == ["editor", "admin"]
+    assert list(reversed(roles)) == ["admin", "editor", "admin"]
+    assert roles.index("editor") == 1 and roles.count("admin") == 2
+    assert "editor" in roles and "owner" not in roles
+    with pytest.raises(IndexError):
+        roles[3]
+    assert roles.tron is tron
+
+
+def test_view_equality_and_offsets():
+    tron = _sample()
+    user = tron.view()["user"]
+    assert user == {"id": 7, "roles": ["admin", "editor", "admin"]}
+    assert user.to_obj() == tron.to_obj(ofs=user.ofs)
+    assert tron.view(ofs=user.ofs) == user
+    with pytest.raises(TypeError):
+        hash(user)
+    with pytest.raises(TronError):
+        tron.view(ofs=tron.buflen() + 8)
+
+
+def test_stale_views_raise():
+    tron = _sample()
+    view = tron.view()
+    roles = view["user"]["roles"]
+    assert repr(roles) == "TronList(['admin', 'editor', 'admin'])"
+    tron.set_str("n", "grown past the old node")
+    for use in (len, list, lambda v: v.to_obj(), lambda v: "admin" in v, lambda v: v[0], repr):
+        with pytest.raises(RuntimeError, match="changed"):
+            use(roles)
+    with pytest.raises(RuntimeError):
+        view["user"]
+    assert tron.view()["n"] == "grown past the old node"
@@ -1,23 +1,46 @@
 from ._tron import (
     DJB2_HASH_SEED,
+    FrozenTron,
+    Key,
     LITE3_NODE_ALIGNMENT,
     LITE3_NODE_SIZE,
     LITE3_ZERO_MEM_8,
+    Path,
+    Pool,
+    Predicate,
     Tron,
+    TronDict,
     TronError,
+    TronList,
     __version__,
+    iter_ndjson,
 )
+from .archive import Archive, ArchiveWriter
 from .py import TronDocument, from_obj, to_obj
+from .stream import StreamReader, StreamWriter, ndjson_to_stream
 
 __all__ = [
+    "Archive",
+    "ArchiveWriter",
     "DJB2_HASH_SEED",
+    "FrozenTron",
+    "Key",
     "LITE3_NODE_ALIGNMENT",
     "LITE3_NODE_SIZE",
     "LITE3_ZERO_MEM_8",
+    "Path",
+    "Pool",
+    "Predicate",
+    "StreamReader",
+    "StreamWriter",
     "Tron",
+    "TronDict",
     "TronDocument",
     "TronError",
+    "TronList",
     "__version__",
     "from_obj",
+    "iter_ndjson",
+    "ndjson_to_stream",
     "to_obj",
 ]
@@ -2,12 +2,20 @@
 #include <Python.h>
 
 #include <errno.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "lite3_context_api.h"
 
 #define TRON_MODULE_VERSION "0.1.0"
@@ -15,9 +23,30 @@
 typedef struct {
     PyObject_HEAD
     lite3_ctx *ctx;
+    Py_ssize_t exports;
+    /* Set for Tron.open_mmap(): ctx->buf points into a read-only file mapping. */
+    unsigned char *mapping;
+    size_t mapping_len;
+    bool copy_on_write;
+    /* Bumped before every mutation so live iterators can detect it. */
+    uint64_t version;
+    /* Held while to_json()/save() read ctx->buf with the GIL released, and by a write from
+     * tron_check_mutable() until its entry point returns. Re-entrant per thread. */
+    PyMutex lock;
+    uintptr_t lock_owner;
+    Py_ssize_t lock_depth;
+    /* FrozenTron only: cached content hash, 0 until first computed. */
+    Py_hash_t hash;
+    /* Set for FrozenTron.from_buffer(): ctx->buf points into this exporter's memory. */
+    Py_buffer source;
+    /* Set for Pool.acquire(): the ctx goes back to this pool instead of being destroyed. */
+    PyObject *pool;
 } TronObject;
 
 static PyObject *TronError;
+static PyTypeObject TronType;
+static PyTypeObject FrozenTronType;
+static void tron_pool_put(PyObject *pool, lite3_ctx *ctx);
 
 static PyObject *tron_raise_errno(const char *msg)
 {
@@ -30,509 +59,614 @@ static PyObject *tron_raise_errno(const char *msg)
     return NULL;
 }
 
-static TronObject *tron_create_with_ctx(PyTypeObject *type, lite3_ctx *ctx)
+/* lite3 has no way to wrap memory it does not own, so a Tron over a file mapping or
+ * another object's buffer gets a bare ctx filled in here, and only here. Invariant: such a
+ * ctx is never grown or written and never reaches lite3_ctx_destroy(); it is freed with
+ * tron_ctx_unwrap(), and tron_check_mutable() swaps in an owned copy before any write. */
+static lite3_ctx *tron_ctx_wrap(const unsigned char *buf, size_t buflen)
 {
-    TronObject *self = (TronObject *)type->tp_alloc(type, 0);
-    if (!self) {
+    lite3_ctx *ctx = (lite3_ctx *)calloc(1, sizeof(lite3_ctx));
+    if (!ctx) {
+        PyErr_NoMemory();
         return NULL;
     }
-    self->ctx = ctx;
-    return self;
+    ctx->buf = (unsigned char *)buf;
+    ctx->buflen = buflen;
+    ctx->bufsz = buflen;
+    return ctx;
 }
 
-static int tron_ctx_set_obj(lite3_ctx *ctx, size_t ofs, const char *key, size_t *out_ofs)
+static void tron_ctx_unwrap(lite3_ctx *ctx)
 {
-    int ret = _lite3_verify_obj_set(ctx->buf, &ctx->buflen, ofs, ctx->bufsz);
-    if (ret < 0) {
-        return ret;
-    }
-
-    errno = 0;
-    while ((ret = lite3_set_obj_impl(
-                    ctx->buf,
-                    &ctx->buflen,
-                    ofs,
-                    ctx->bufsz,
-                    key,
-                    lite3_get_key_data(key),
-                    out_ofs)) < 0) {
-        if (errno == ENOBUFS && (lite3_ctx_grow_impl(ctx) == 0)) {
-            continue;
-        }
-        return ret;
-    }
-
-    return ret;
+    free(ctx);
 }
 
-static int tron_ctx_set_arr(lite3_ctx *ctx, size_t ofs, const char *key, size_t *out_ofs)
+static void tron_release_ctx(TronObject *self)
 {
-    int ret = _lite3_verify_obj_set(ctx->buf, &ctx->buflen, ofs, ctx->bufsz);
-    if (ret < 0) {
-        return ret;
+    if (!self->ctx) {
+        return;
+    }
+
+    if (self->mapping) {
+#ifndef _WIN32
+        munmap(self->mapping, self->mapping_len);
+#endif
+        tron_ctx_unwrap(self->ctx);
+        self->mapping = NULL;
+        self->mapping_len = 0;
+    } else if (self->source.obj) {
+        tron_ctx_unwrap(self->ctx);
+        PyBuffer_Release(&self->source);
+    } else {
+        lite3_ctx_destroy(self->ctx);
     }
+    self->ctx = NULL;
+}
 
-    errno = 0;
-    while ((ret = lite3_set_arr_impl(
-                    ctx->buf,
-                    &ctx->buflen,
-                    ofs,
-                    ctx->bufsz,
-                    key,
-                    lite3_get_key_data(key),
-                    out_ofs)) < 0) {
-        if (errno == ENOBUFS && (lite3_ctx_grow_impl(ctx) == 0)) {
-            continue;
-        }
-        return ret;
+static int tron_promote_mapping(TronObject *self)
+{
+    lite3_ctx *ctx = lite3_ctx_create_from_buf(self->ctx->buf, self->ctx->buflen);
+    if (!ctx) {
+        tron_raise_errno("lite3_ctx_create_from_buf");
+        return -1;
     }
 
-    return ret;
+    tron_release_ctx(self);
+    self->ctx = ctx;
+    return 0;
 }
 
-static int tron_ctx_get(lite3_ctx *ctx, size_t ofs, const char *key, lite3_val **out)
+/* A FrozenTron or read-only mapping can never change, so its readers need no locking. */
+static inline bool tron_is_frozen(TronObject *self)
 {
-    int ret = _lite3_verify_obj_get(ctx->buf, ctx->buflen, ofs);
-    if (ret < 0) {
-        return ret;
-    }
-    return lite3_get_impl(ctx->buf, ctx->buflen, ofs, key, lite3_get_key_data(key), out);
+    return Py_IS_TYPE(self, &FrozenTronType) || (self->mapping && !self->copy_on_write);
 }
 
-static int Tron_init(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Plain accesses with the GIL, atomics on free-threaded builds (CPython's FT_ATOMIC_*). */
+#ifdef Py_GIL_DISABLED
+#define TRON_ATOMIC_LOAD_UINTPTR_RELAXED(value) _Py_atomic_load_uintptr_relaxed(&(value))
+#define TRON_ATOMIC_STORE_UINTPTR_RELAXED(value, new_value) _Py_atomic_store_uintptr_relaxed(&(value), (new_value))
+#define TRON_ATOMIC_LOAD_SSIZE_RELAXED(value) _Py_atomic_load_ssize_relaxed(&(value))
+#define TRON_ATOMIC_STORE_SSIZE_RELAXED(value, new_value) _Py_atomic_store_ssize_relaxed(&(value), (new_value))
+#define TRON_ATOMIC_LOAD_PTR_ACQUIRE(value) _Py_atomic_load_ptr_acquire(&(value))
+#define TRON_ATOMIC_STORE_PTR_RELEASE(value, new_value) _Py_atomic_store_ptr_release(&(value), (new_value))
+#else
+#define TRON_ATOMIC_LOAD_UINTPTR_RELAXED(value) (value)
+#define TRON_ATOMIC_STORE_UINTPTR_RELAXED(value, new_value) ((value) = (new_value))
+#define TRON_ATOMIC_LOAD_SSIZE_RELAXED(value) (value)
+#define TRON_ATOMIC_STORE_SSIZE_RELAXED(value, new_value) ((value) = (new_value))
+#define TRON_ATOMIC_LOAD_PTR_ACQUIRE(value) (value)
+#define TRON_ATOMIC_STORE_PTR_RELEASE(value, new_value) ((value) = (new_value))
+#endif
+
+/* Lock depth the calling thread holds on self, 0 if it holds none. Only the owner ever
+ * stores its own id, so a relaxed load is enough to recognise it. */
+static Py_ssize_t tron_lock_held(TronObject *self)
 {
-    const char *root = "object";
-    Py_ssize_t bufsz = 0;
-    static char *kwlist[] = {"root", "bufsz", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sn", kwlist, &root, &bufsz)) {
-        return -1;
-    }
-
-    if (bufsz > 0) {
-        self->ctx = lite3_ctx_create_with_size((size_t)bufsz);
-    } else {
-        self->ctx = lite3_ctx_create();
-    }
-
-    if (!self->ctx) {
-        tron_raise_errno("lite3_ctx_create");
-        return -1;
-    }
+    uintptr_t me = (uintptr_t)PyThread_get_thread_ident();
+    return TRON_ATOMIC_LOAD_UINTPTR_RELAXED(self->lock_owner) == me ? self->lock_depth : 0;
+}
 
-    int ret = 0;
-    if (strcmp(root, "object") == 0) {
-        ret = lite3_ctx_init_obj(self->ctx);
-    } else if (strcmp(root, "array") == 0) {
-        ret = lite3_ctx_init_arr(self->ctx);
-    } else {
-        lite3_ctx_destroy(self->ctx);
-        self->ctx = NULL;
-        PyErr_SetString(PyExc_ValueError, "root must be 'object' or 'array'");
-        return -1;
+/* Blocks with the thread state detached, so a Python callback made while the lock is held
+ * can re-enter the same Tron on this thread without deadlocking. */
+static void tron_lock(TronObject *self)
+{
+    if (tron_lock_held(self)) {
+        self->lock_depth++;
+        return;
     }
+    PyMutex_Lock(&self->lock);
+    TRON_ATOMIC_STORE_UINTPTR_RELAXED(self->lock_owner, (uintptr_t)PyThread_get_thread_ident());
+    self->lock_depth = 1;
+}
 
-    if (ret < 0) {
-        tron_raise_errno("lite3_ctx_init");
-        lite3_ctx_destroy(self->ctx);
-        self->ctx = NULL;
-        return -1;
+static void tron_unlock(TronObject *self)
+{
+    if (--self->lock_depth == 0) {
+        TRON_ATOMIC_STORE_UINTPTR_RELAXED(self->lock_owner, 0);
+        PyMutex_Unlock(&self->lock);
     }
-
-    return 0;
 }
 
-static void Tron_dealloc(TronObject *self)
+/* Drops the locks this thread took since tron_lock_held() returned depth. */
+static void tron_unlock_to(TronObject *self, Py_ssize_t depth)
 {
-    if (self->ctx) {
-        lite3_ctx_destroy(self->ctx);
-        self->ctx = NULL;
+    Py_ssize_t held = tron_lock_held(self);
+    while (held-- > depth) {
+        tron_unlock(self);
     }
-    Py_TYPE(self)->tp_free((PyObject *)self);
 }
 
-static PyObject *Tron_init_obj(TronObject *self, PyObject *Py_UNUSED(args))
+static void tron_read_begin(TronObject *self)
 {
-    if (lite3_ctx_init_obj(self->ctx) < 0) {
-        return tron_raise_errno("lite3_ctx_init_obj");
+    if (!tron_is_frozen(self)) {
+        tron_lock(self);
     }
-    Py_RETURN_NONE;
 }
 
-static PyObject *Tron_init_arr(TronObject *self, PyObject *Py_UNUSED(args))
+static void tron_read_end(TronObject *self)
 {
-    if (lite3_ctx_init_arr(self->ctx) < 0) {
-        return tron_raise_errno("lite3_ctx_init_arr");
+    if (!tron_is_frozen(self)) {
+        tron_unlock(self);
     }
-    Py_RETURN_NONE;
 }
 
-static PyObject *Tron_set_null(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Growth may realloc ctx->buf, so nothing may change while a view is exported. On success
+ * the lock stays held for the whole write; the TRON_LOCKED wrapper releases it. The
+ * exports check comes after taking it, since tron_lock() may detach and let a
+ * getbuffer in. */
+static int tron_check_mutable(TronObject *self)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
+    if (Py_IS_TYPE(self, &FrozenTronType)) {
+        PyErr_SetString(TronError, "FrozenTron is read-only");
+        return -1;
+    }
+    tron_lock(self);
+    if (self->exports > 0) {
+        PyErr_SetString(PyExc_BufferError, "cannot modify Tron while its buffer is exported");
+        goto error;
     }
 
-    if (lite3_ctx_set_null(self->ctx, (size_t)ofs, key) < 0) {
-        return tron_raise_errno("lite3_ctx_set_null");
+    if (self->mapping) {
+        if (!self->copy_on_write) {
+            PyErr_SetString(TronError, "Tron is a read-only memory map (open with copy_on_write=True to modify)");
+            goto error;
+        }
+        if (tron_promote_mapping(self) < 0) {
+            goto error;
+        }
     }
 
-    Py_RETURN_NONE;
+    self->version++;
+    return 0;
+
+error:
+    tron_unlock(self);
+    return -1;
 }
 
-static PyObject *Tron_set_bool(TronObject *self, PyObject *args, PyObject *kwargs)
+static void tron_raise_released(void)
 {
-    const char *key = NULL;
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "value", "ofs", NULL};
+    PyErr_SetString(PyExc_ValueError, "Tron has no buffer (released to its pool)");
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|n", kwlist, &key, &value_obj, &ofs)) {
-        return NULL;
-    }
+/* Argument Clinic's @critical_section, by hand: on free-threaded builds every entry point
+ * runs inside a critical section on the owning Tron, so a grow can never race a reader.
+ * With the GIL the macros reduce to braces. Frozen documents skip the lock. The same
+ * wrapper rejects Trons whose ctx went back to a Pool, returning err, and drops the write
+ * lock tron_check_mutable() took. */
+#define TRON_LOCKED(rtype, err, name, owner, params, call)                                   \
+    static rtype name##_locked params                                                      \
+    {                                                                                       \
+        TronObject *tron_owner = (owner);                                                   \
+        if (tron_is_frozen(tron_owner) && tron_owner->ctx) {                                \
+            return name call;                                                               \
+        }                                                                                   \
+        rtype result = err;                                                                 \
+        Py_BEGIN_CRITICAL_SECTION(tron_owner);                                              \
+        if (tron_owner->ctx) {                                                              \
+            Py_ssize_t tron_depth = tron_lock_held(tron_owner);                             \
+            result = name call;                                                             \
+            tron_unlock_to(tron_owner, tron_depth);                                         \
+        } else {                                                                            \
+            tron_raise_released();                                                          \
+        }                                                                                   \
+        Py_END_CRITICAL_SECTION();                                                          \
+        return result;                                                                      \
+    }
+
+#define TRON_LOCKED_FASTCALL(name)                                                           \
+    TRON_LOCKED(PyObject *, NULL, name, self,                                               \
+                (TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames), \
+                (self, args, nargs, kwnames))
+#define TRON_LOCKED_O(name) \
+    TRON_LOCKED(PyObject *, NULL, name, self, (TronObject *self, PyObject *arg), (self, arg))
 
-    int truth = PyObject_IsTrue(value_obj);
-    if (truth < 0) {
+static TronObject *tron_create_with_ctx(PyTypeObject *type, lite3_ctx *ctx)
+{
+    TronObject *self = (TronObject *)type->tp_alloc(type, 0);
+    if (!self) {
         return NULL;
     }
+    self->ctx = ctx;
+    return self;
+}
 
-    if (lite3_ctx_set_bool(self->ctx, (size_t)ofs, key, truth != 0) < 0) {
-        return tron_raise_errno("lite3_ctx_set_bool");
+/* METH_FASTCALL | METH_KEYWORDS argument parsing in the spirit of CPython's private
+ * _PyArg_Parser: each method keeps a static parser whose keyword names are interned on
+ * first keyword use, so calls match keywords by pointer and never build a tuple/dict.
+ * Every parameter is positional-or-keyword; out[i] is borrowed, or NULL when omitted. */
+typedef struct {
+    const char *fname;
+    const char *const *keywords;
+    Py_ssize_t required;
+    Py_ssize_t count;
+    PyObject **names;
+} tron_argparser;
+
+#define TRON_ARGPARSER(var, fname, required, ...)                                              \
+    static const char *const var##_keywords[] = {__VA_ARGS__, NULL};                           \
+    static PyObject *var##_names[sizeof(var##_keywords) / sizeof(var##_keywords[0]) - 1];      \
+    static tron_argparser var = {                                                              \
+        fname, var##_keywords, required, sizeof(var##_keywords) / sizeof(var##_keywords[0]) - 1, \
+        var##_names}
+
+static PyMutex tron_argparser_mutex;
+
+static Py_ssize_t tron_argparser_find(tron_argparser *parser, PyObject *kwname)
+{
+    /* Interned once under a mutex. The last name is published with a release store after
+     * the others, so a reader whose acquire load sees it also sees every earlier name;
+     * one that sees NULL takes the mutex and reads them there. */
+    PyObject **last = &parser->names[parser->count - 1];
+    if (!TRON_ATOMIC_LOAD_PTR_ACQUIRE(*last)) {
+        int failed = 0;
+        PyMutex_Lock(&tron_argparser_mutex);
+        for (Py_ssize_t i = 0; i < parser->count && !failed; i++) {
+            if (!parser->names[i]) {
+                PyObject *name = PyUnicode_InternFromString(parser->keywords[i]);
+                failed = name == NULL;
+                if (&parser->names[i] == last) {
+                    TRON_ATOMIC_STORE_PTR_RELEASE(*last, name);
+                } else {
+                    parser->names[i] = name;
+                }
+            }
+        }
+        PyMutex_Unlock(&tron_argparser_mutex);
+        if (failed) {
+            return -2;
+        }
     }
 
-    Py_RETURN_NONE;
+    for (Py_ssize_t i = 0; i < parser->count; i++) {
+        if (parser->names[i] == kwname) {
+            return i;
+        }
+    }
+    /* Keyword names are almost always interned already; this covers the rest. */
+    for (Py_ssize_t i = 0; i < parser->count; i++) {
+        if (PyUnicode_CompareWithASCIIString(kwname, parser->keywords[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-static PyObject *Tron_set_i64(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_parse_args(tron_argparser *parser, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames, PyObject **out)
 {
-    const char *key = NULL;
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|n", kwlist, &key, &value_obj, &ofs)) {
-        return NULL;
+    if (nargs > parser->count) {
+        PyErr_Format(PyExc_TypeError, "%s() takes at most %zd argument%s (%zd given)",
+                     parser->fname, parser->count, parser->count == 1 ? "" : "s", nargs);
+        return -1;
     }
 
-    long long value = PyLong_AsLongLong(value_obj);
-    if (PyErr_Occurred()) {
-        return NULL;
+    for (Py_ssize_t i = 0; i < nargs; i++) {
+        out[i] = args[i];
+    }
+    for (Py_ssize_t i = nargs; i < parser->count; i++) {
+        out[i] = NULL;
+    }
+
+    if (kwnames) {
+        Py_ssize_t nkw = PyTuple_GET_SIZE(kwnames);
+        for (Py_ssize_t k = 0; k < nkw; k++) {
+            PyObject *kwname = PyTuple_GET_ITEM(kwnames, k);
+            Py_ssize_t slot = tron_argparser_find(parser, kwname);
+            if (slot == -2) {
+                return -1;
+            }
+            if (slot < 0) {
+                PyErr_Format(PyExc_TypeError, "%s() got an unexpected keyword argument '%U'", parser->fname, kwname);
+                return -1;
+            }
+            if (out[slot]) {
+                PyErr_Format(PyExc_TypeError, "%s() got multiple values for argument '%s'",
+                             parser->fname, parser->keywords[slot]);
+                return -1;
+            }
+            out[slot] = args[nargs + k];
+        }
     }
 
-    if (lite3_ctx_set_i64(self->ctx, (size_t)ofs, key, (int64_t)value) < 0) {
-        return tron_raise_errno("lite3_ctx_set_i64");
+    for (Py_ssize_t i = 0; i < parser->required; i++) {
+        if (!out[i]) {
+            PyErr_Format(PyExc_TypeError, "%s() missing required argument '%s' (pos %zd)",
+                         parser->fname, parser->keywords[i], i + 1);
+            return -1;
+        }
     }
 
-    Py_RETURN_NONE;
+    return 0;
 }
 
-static PyObject *Tron_set_f64(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Argument converters for tron_parse_args() output: NULL (omitted) keeps the default in *out. */
+static int tron_arg_ssize(PyObject *obj, Py_ssize_t *out)
 {
-    const char *key = NULL;
-    double value = 0.0;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sd|n", kwlist, &key, &value, &ofs)) {
-        return NULL;
+    if (!obj) {
+        return 0;
     }
-
-    if (lite3_ctx_set_f64(self->ctx, (size_t)ofs, key, value) < 0) {
-        return tron_raise_errno("lite3_ctx_set_f64");
+    Py_ssize_t value = PyLong_CheckExact(obj) ? PyLong_AsSsize_t(obj) : PyNumber_AsSsize_t(obj, PyExc_OverflowError);
+    if (value == -1 && PyErr_Occurred()) {
+        return -1;
     }
-
-    Py_RETURN_NONE;
+    *out = value;
+    return 0;
 }
 
-static PyObject *Tron_set_bytes(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_arg_ulong(PyObject *obj, unsigned long *out)
 {
-    const char *key = NULL;
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|n", kwlist, &key, &value_obj, &ofs)) {
-        return NULL;
+    if (!obj) {
+        return 0;
     }
-
-    Py_buffer view;
-    if (PyObject_GetBuffer(value_obj, &view, PyBUF_SIMPLE) < 0) {
-        return NULL;
+    if (!PyLong_Check(obj)) {
+        PyErr_Format(PyExc_TypeError, "expected int, not %.200s", Py_TYPE(obj)->tp_name);
+        return -1;
     }
+    *out = PyLong_AsUnsignedLongMask(obj);
+    return (*out == (unsigned long)-1 && PyErr_Occurred()) ? -1 : 0;
+}
 
-    int ret = lite3_ctx_set_bytes(self->ctx, (size_t)ofs, key, (const unsigned char *)view.buf, (size_t)view.len);
-    PyBuffer_Release(&view);
-    if (ret < 0) {
-        return tron_raise_errno("lite3_ctx_set_bytes");
+static int tron_arg_i64(PyObject *obj, int64_t *out)
+{
+    if (!obj) {
+        return 0;
     }
-
-    Py_RETURN_NONE;
+    long long value = PyLong_AsLongLong(obj);
+    if (value == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    *out = (int64_t)value;
+    return 0;
 }
 
-static PyObject *Tron_set_str(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_arg_f64(PyObject *obj, double *out)
 {
-    const char *key = NULL;
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sO|n", kwlist, &key, &value_obj, &ofs)) {
-        return NULL;
+    if (!obj) {
+        return 0;
     }
-
-    Py_ssize_t value_len = 0;
-    const char *value = PyUnicode_AsUTF8AndSize(value_obj, &value_len);
-    if (!value) {
-        return NULL;
+    if (PyFloat_CheckExact(obj)) {
+        *out = PyFloat_AS_DOUBLE(obj);
+        return 0;
     }
-
-    if (lite3_ctx_set_str_n(self->ctx, (size_t)ofs, key, value, (size_t)value_len) < 0) {
-        return tron_raise_errno("lite3_ctx_set_str_n");
+    double value = PyFloat_AsDouble(obj);
+    if (value == -1.0 && PyErr_Occurred()) {
+        return -1;
     }
-
-    Py_RETURN_NONE;
+    *out = value;
+    return 0;
 }
 
-static PyObject *Tron_set_obj(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_arg_bool(PyObject *obj, int *out)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
+    if (!obj) {
+        return 0;
     }
-
-    size_t out_ofs = 0;
-    if (tron_ctx_set_obj(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_set_obj_impl");
+    int truth = PyObject_IsTrue(obj);
+    if (truth < 0) {
+        return -1;
     }
-
-    return PyLong_FromSize_t(out_ofs);
+    *out = truth;
+    return 0;
 }
 
-static PyObject *Tron_set_arr(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_arg_cstr(PyObject *obj, const char **out)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
+    if (!obj) {
+        return 0;
     }
-
-    size_t out_ofs = 0;
-    if (tron_ctx_set_arr(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_set_arr_impl");
+    if (!PyUnicode_Check(obj)) {
+        PyErr_Format(PyExc_TypeError, "expected str, not %.200s", Py_TYPE(obj)->tp_name);
+        return -1;
     }
-
-    return PyLong_FromSize_t(out_ofs);
+    Py_ssize_t len = 0;
+    const char *str = PyUnicode_AsUTF8AndSize(obj, &len);
+    if (!str) {
+        return -1;
+    }
+    if (strlen(str) != (size_t)len) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        return -1;
+    }
+    *out = str;
+    return 0;
 }
 
-static PyObject *Tron_get_bool(TronObject *self, PyObject *args, PyObject *kwargs)
+/* PySequence_Fast() whose items stay put while Python code runs and other threads write:
+ * a caller's list is copied (under its own lock on free-threaded builds). */
+static PyObject *tron_arg_items(PyObject *obj, const char *message)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
+    PyObject *seq = PySequence_Fast(obj, message);
+    if (seq == obj && PyList_Check(seq)) {
+        Py_SETREF(seq, PyList_AsTuple(seq));
     }
+    return seq;
+}
 
-    bool value = false;
-    if (lite3_ctx_get_bool(self->ctx, (size_t)ofs, key, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_get_bool");
-    }
+/* A key as the lite3 *_impl functions take it: UTF-8 plus its precomputed DJB2 hash/size. */
+typedef struct {
+    const char *key;
+    lite3_key_data key_data;
+} tron_key;
 
-    if (value) {
-        Py_RETURN_TRUE;
-    }
-    Py_RETURN_FALSE;
-}
+typedef struct {
+    PyObject_HEAD
+    PyObject *name;
+    tron_key key;
+} KeyObject;
 
-static PyObject *Tron_get_i64(TronObject *self, PyObject *args, PyObject *kwargs)
-{
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
+static PyTypeObject KeyType;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
+/* Compiled "a.b[3].c" style path: one pre-hashed key or array index per segment. */
+typedef struct {
+    tron_key key; /* key.key is NULL for an array index segment */
+    uint32_t index;
+} tron_path_seg;
 
-    int64_t value = 0;
-    if (lite3_ctx_get_i64(self->ctx, (size_t)ofs, key, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_get_i64");
-    }
+typedef struct {
+    PyObject_VAR_HEAD
+    PyObject *source;
+    char *keybuf;
+    tron_path_seg segs[];
+} PathObject;
+
+static PyTypeObject PathType;
+
+enum tron_pred_op {
+    TRON_PRED_AND,
+    TRON_PRED_OR,
+    TRON_PRED_NOT,
+    TRON_PRED_EQ,
+    TRON_PRED_NE,
+    TRON_PRED_LT,
+    TRON_PRED_LE,
+    TRON_PRED_GT,
+    TRON_PRED_GE,
+};
 
-    return PyLong_FromLongLong((long long)value);
+static const char *const tron_pred_op_names[] = {"and", "or", "not", "==", "!=", "<", "<=", ">", ">="};
+
+enum tron_pred_kind {
+    TRON_PRED_NULL,
+    TRON_PRED_BOOL,
+    TRON_PRED_I64,
+    TRON_PRED_F64,
+    TRON_PRED_STR,
+};
+
+/* Predicate nodes are stored in prefix order: a node's children follow it directly,
+ * and size (the node count of its subtree) skips to the next sibling. */
+typedef struct {
+    uint8_t op;
+    uint8_t kind;
+    uint32_t size;
+    const PathObject *field;
+    union {
+        bool b;
+        int64_t i64;
+        double f64;
+        struct {
+            const char *ptr;
+            size_t len;
+        } str;
+    } value;
+} tron_pred_node;
+
+/* Compiled where= clause of Tron.select(); refs keeps the paths and str values that
+ * the nodes point into alive. */
+typedef struct {
+    PyObject_VAR_HEAD
+    PyObject *spec;
+    PyObject *refs;
+    tron_pred_node nodes[];
+} PredicateObject;
+
+static PyTypeObject PredicateType;
+
+/* Same verify + grow-on-ENOBUFS loop as the lite3_ctx_set_* macros, minus the key hashing. */
+#define TRON_CTX_SET_RETRY(ctx, ofs, set_call)                                                  \
+    do {                                                                                        \
+        int ret_ = _lite3_verify_obj_set((ctx)->buf, &(ctx)->buflen, (ofs), (ctx)->bufsz);      \
+        if (ret_ < 0) {                                                                         \
+            return ret_;                                                                        \
+        }                                                                                       \
+        errno = 0;                                                                              \
+        while ((ret_ = (set_call)) < 0) {                                                       \
+            if (errno == ENOBUFS && (lite3_ctx_grow_impl(ctx) == 0)) {                          \
+                continue;                                                                       \
+            }                                                                                   \
+            return ret_;                                                                        \
+        }                                                                                       \
+        return ret_;                                                                            \
+    } while (0)
+
+static int tron_ctx_set_null(lite3_ctx *ctx, size_t ofs, const tron_key *key)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_null_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data));
 }
 
-static PyObject *Tron_get_f64(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_ctx_set_bool(lite3_ctx *ctx, size_t ofs, const tron_key *key, bool value)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_bool_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, value));
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
+static int tron_ctx_set_i64(lite3_ctx *ctx, size_t ofs, const tron_key *key, int64_t value)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_i64_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, value));
+}
 
-    double value = 0.0;
-    if (lite3_ctx_get_f64(self->ctx, (size_t)ofs, key, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_get_f64");
-    }
+static int tron_ctx_set_f64(lite3_ctx *ctx, size_t ofs, const tron_key *key, double value)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_f64_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, value));
+}
 
-    return PyFloat_FromDouble(value);
+static int tron_ctx_set_bytes(lite3_ctx *ctx, size_t ofs, const tron_key *key, const unsigned char *bytes, size_t len)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_bytes_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, bytes, len));
 }
 
-static PyObject *Tron_get_bytes(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_ctx_set_str(lite3_ctx *ctx, size_t ofs, const tron_key *key, const char *str, size_t len)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
+    TRON_CTX_SET_RETRY(ctx, ofs, _lite3_set_str_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, str, len));
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
+static int tron_ctx_set_obj(lite3_ctx *ctx, size_t ofs, const tron_key *key, size_t *out_ofs)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, lite3_set_obj_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, out_ofs));
+}
 
-    lite3_bytes value;
-    if (lite3_ctx_get_bytes(self->ctx, (size_t)ofs, key, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_get_bytes");
-    }
+static int tron_ctx_set_arr(lite3_ctx *ctx, size_t ofs, const tron_key *key, size_t *out_ofs)
+{
+    TRON_CTX_SET_RETRY(ctx, ofs, lite3_set_arr_impl(
+        ctx->buf, &ctx->buflen, ofs, ctx->bufsz, key->key, key->key_data, out_ofs));
+}
 
-    const unsigned char *bytes = LITE3_BYTES(self->ctx->buf, value);
-    if (!bytes) {
-        PyErr_SetString(TronError, "stale bytes reference");
-        return NULL;
+static int tron_ctx_get(lite3_ctx *ctx, size_t ofs, const tron_key *key, lite3_val **out)
+{
+    int ret = _lite3_verify_obj_get(ctx->buf, ctx->buflen, ofs);
+    if (ret < 0) {
+        return ret;
     }
-
-    return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)value.len);
+    return lite3_get_impl(ctx->buf, ctx->buflen, ofs, key->key, key->key_data, out);
 }
 
-static PyObject *Tron_get_str(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_ctx_get_typed(lite3_ctx *ctx, size_t ofs, const tron_key *key, enum lite3_type type, lite3_val **out)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
-
-    lite3_str value;
-    if (lite3_ctx_get_str(self->ctx, (size_t)ofs, key, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_get_str");
-    }
-
-    const char *str = LITE3_STR(self->ctx->buf, value);
-    if (!str) {
-        PyErr_SetString(TronError, "stale string reference");
-        return NULL;
-    }
-
-    return PyUnicode_FromStringAndSize(str, (Py_ssize_t)value.len);
-}
-
-static PyObject *Tron_get_obj(TronObject *self, PyObject *args, PyObject *kwargs)
-{
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
+    int ret = tron_ctx_get(ctx, ofs, key, out);
+    if (ret < 0) {
+        return ret;
     }
-
-    size_t out_ofs = 0;
-    if (lite3_ctx_get_obj(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_get_obj");
+    if (lite3_val_type(*out) != type) {
+        errno = EINVAL;
+        return -1;
     }
-
-    return PyLong_FromSize_t(out_ofs);
+    return ret;
 }
-
-static PyObject *Tron_get_arr(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_ctx_arr_get(lite3_ctx *ctx, size_t ofs, uint32_t index, lite3_val **out)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
-
-    size_t out_ofs = 0;
-    if (lite3_ctx_get_arr(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_get_arr");
+    int ret = _lite3_verify_arr_get(ctx->buf, ctx->buflen, ofs);
+    if (ret < 0) {
+        return ret;
     }
-
-    return PyLong_FromSize_t(out_ofs);
+    return _lite3_get_by_index(ctx->buf, ctx->buflen, ofs, index, out);
 }
 
-static const char *tron_type_name(enum lite3_type type)
-{
-    switch (type) {
-    case LITE3_TYPE_NULL:
-        return "null";
-    case LITE3_TYPE_BOOL:
-        return "bool";
-    case LITE3_TYPE_I64:
-        return "i64";
-    case LITE3_TYPE_F64:
-        return "f64";
-    case LITE3_TYPE_BYTES:
-        return "bytes";
-    case LITE3_TYPE_STRING:
-        return "string";
-    case LITE3_TYPE_OBJECT:
-        return "object";
-    case LITE3_TYPE_ARRAY:
-        return "array";
-    default:
-        return "unknown";
-    }
-}
 
-static PyObject *Tron_get_type(TronObject *self, PyObject *args, PyObject *kwargs)
+static size_t tron_val_ofs(const lite3_ctx *ctx, const lite3_val *val)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
-
-    enum lite3_type type = lite3_ctx_get_type(self->ctx, (size_t)ofs, key);
-    if (type == LITE3_TYPE_INVALID) {
-        return tron_raise_errno("lite3_ctx_get_type");
-    }
-
-    return PyUnicode_FromString(tron_type_name(type));
+    return (size_t)((const unsigned char *)val - ctx->buf);
 }
-
-static PyObject *Tron_get(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Scalars decode to Python values; nested objects/arrays come back as their offset. */
+static PyObject *tron_val_to_py(const lite3_ctx *ctx, const lite3_val *val)
 {
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
-
-    lite3_val *val = NULL;
-    if (tron_ctx_get(self->ctx, (size_t)ofs, key, &val) < 0) {
-        return tron_raise_errno("lite3_get_impl");
-    }
-
-    enum lite3_type type = lite3_val_type(val);
-    switch (type) {
+    switch (lite3_val_type(val)) {
     case LITE3_TYPE_NULL:
         Py_RETURN_NONE;
     case LITE3_TYPE_BOOL:
@@ -551,673 +685,6427 @@ static PyObject *Tron_get(TronObject *self, PyObject *args, PyObject *kwargs)
         const unsigned char *bytes = lite3_val_bytes(val, &len);
         return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)len);
     }
-    case LITE3_TYPE_OBJECT: {
-        size_t out_ofs = 0;
-        if (lite3_ctx_get_obj(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-            return tron_raise_errno("lite3_ctx_get_obj");
-        }
-        return PyLong_FromSize_t(out_ofs);
-    }
-    case LITE3_TYPE_ARRAY: {
-        size_t out_ofs = 0;
-        if (lite3_ctx_get_arr(self->ctx, (size_t)ofs, key, &out_ofs) < 0) {
-            return tron_raise_errno("lite3_ctx_get_arr");
-        }
-        return PyLong_FromSize_t(out_ofs);
-    }
+    case LITE3_TYPE_OBJECT:
+    case LITE3_TYPE_ARRAY:
+        return PyLong_FromSize_t(tron_val_ofs(ctx, val));
     default:
         PyErr_SetString(TronError, "unknown value type");
         return NULL;
     }
 }
 
-static PyObject *Tron_exists(TronObject *self, PyObject *args, PyObject *kwargs)
-{
-    const char *key = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"key", "ofs", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|n", kwlist, &key, &ofs)) {
-        return NULL;
-    }
+/* Python value -> TRON value. A NULL key appends to the array at ofs instead. */
+static int tron_put_value(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value);
 
-    bool exists = lite3_exists(self->ctx->buf, self->ctx->buflen, (size_t)ofs, key);
-    if (exists) {
-        Py_RETURN_TRUE;
-    }
-    Py_RETURN_FALSE;
+static int tron_put_failed(const tron_key *key, const char *set_name, const char *append_name)
+{
+    tron_raise_errno(key ? set_name : append_name);
+    return -1;
 }
 
-static PyObject *Tron_arr_append_null(TronObject *self, PyObject *args, PyObject *kwargs)
+static const char *tron_key_from_py(PyObject *key_obj)
 {
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"ofs", NULL};
+    if (!PyUnicode_Check(key_obj)) {
+        PyErr_SetString(PyExc_TypeError, "object keys must be strings");
+        return NULL;
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", kwlist, &ofs)) {
+    Py_ssize_t key_len = 0;
+    const char *key = PyUnicode_AsUTF8AndSize(key_obj, &key_len);
+    if (!key) {
         return NULL;
     }
 
-    if (lite3_ctx_arr_append_null(self->ctx, (size_t)ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_null");
+    if (strlen(key) != (size_t)key_len) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character in key");
+        return NULL;
     }
 
-    Py_RETURN_NONE;
+    return key;
 }
 
-static PyObject *Tron_arr_append_bool(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Method keys: a tron.Key is used as-is, a str is hashed on the spot. */
+static int tron_arg_key(PyObject *key_obj, tron_key *out)
 {
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwlist, &value_obj, &ofs)) {
-        return NULL;
+    if (Py_IS_TYPE(key_obj, &KeyType)) {
+        *out = ((KeyObject *)key_obj)->key;
+        return 0;
     }
 
-    int truth = PyObject_IsTrue(value_obj);
-    if (truth < 0) {
-        return NULL;
+    if (!PyUnicode_Check(key_obj)) {
+        PyErr_Format(PyExc_TypeError, "key must be str or tron.Key, not %.200s", Py_TYPE(key_obj)->tp_name);
+        return -1;
     }
 
-    if (lite3_ctx_arr_append_bool(self->ctx, (size_t)ofs, truth != 0) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_bool");
+    out->key = tron_key_from_py(key_obj);
+    if (!out->key) {
+        return -1;
     }
-
-    Py_RETURN_NONE;
+    out->key_data = lite3_get_key_data(out->key);
+    return 0;
 }
 
-static PyObject *Tron_arr_append_i64(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Splits "a.b[3].c" into segments. With segs == NULL it only validates and counts;
+ * otherwise key names are copied NUL-terminated into keybuf (len + 1 bytes suffice). */
+static Py_ssize_t tron_path_parse(PyObject *source, const char *text, size_t len, tron_path_seg *segs, char *keybuf)
 {
-    long long value = 0;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "L|n", kwlist, &value, &ofs)) {
-        return NULL;
+    Py_ssize_t count = 0;
+    size_t pos = 0;
+
+    if (len == 0) {
+        goto invalid;
+    }
+
+    while (pos < len) {
+        if (text[pos] == '[') {
+            size_t start = ++pos;
+            uint64_t index = 0;
+            while (pos < len && text[pos] >= '0' && text[pos] <= '9') {
+                index = index * 10 + (uint64_t)(text[pos] - '0');
+                if (index > UINT32_MAX) {
+                    goto invalid;
+                }
+                pos++;
+            }
+            if (pos == start || pos == len || text[pos] != ']') {
+                goto invalid;
+            }
+            pos++;
+            if (segs) {
+                segs[count].key.key = NULL;
+                segs[count].index = (uint32_t)index;
+            }
+        } else {
+            size_t start = pos;
+            while (pos < len && text[pos] != '.' && text[pos] != '[' && text[pos] != ']') {
+                pos++;
+            }
+            if (pos == start) {
+                goto invalid;
+            }
+            if (segs) {
+                memcpy(keybuf, text + start, pos - start);
+                keybuf[pos - start] = '\0';
+                segs[count].key.key = keybuf;
+                segs[count].key.key_data = lite3_get_key_data(keybuf);
+                segs[count].index = 0;
+                keybuf += pos - start + 1;
+            }
+        }
+        count++;
+
+        if (pos < len && text[pos] == '.') {
+            pos++;
+            if (pos == len || text[pos] == '[') {
+                goto invalid;
+            }
+        } else if (pos < len && text[pos] != '[') {
+            goto invalid;
+        }
     }
 
-    if (lite3_ctx_arr_append_i64(self->ctx, (size_t)ofs, (int64_t)value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_i64");
-    }
+    return count;
 
-    Py_RETURN_NONE;
+invalid:
+    PyErr_Format(PyExc_ValueError, "invalid path: %R", source);
+    return -1;
 }
 
-static PyObject *Tron_arr_append_f64(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Path from a "a.b[3].c" string or a sequence of str/tron.Key/int segments. */
+static PyObject *tron_path_compile(PyTypeObject *type, PyObject *source)
 {
-    double value = 0.0;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"value", "ofs", NULL};
+    PathObject *self = NULL;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|n", kwlist, &value, &ofs)) {
-        return NULL;
-    }
+    if (PyUnicode_Check(source)) {
+        Py_ssize_t len = 0;
+        const char *text = PyUnicode_AsUTF8AndSize(source, &len);
+        if (!text) {
+            return NULL;
+        }
+        if (strlen(text) != (size_t)len) {
+            PyErr_SetString(PyExc_ValueError, "embedded null character in path");
+            return NULL;
+        }
 
-    if (lite3_ctx_arr_append_f64(self->ctx, (size_t)ofs, value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_f64");
+        Py_ssize_t count = tron_path_parse(source, text, (size_t)len, NULL, NULL);
+        if (count < 0) {
+            return NULL;
+        }
+        self = (PathObject *)type->tp_alloc(type, count);
+        if (!self) {
+            return NULL;
+        }
+        self->keybuf = PyMem_Malloc((size_t)len + 1);
+        if (!self->keybuf) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+        self->source = Py_NewRef(source);
+        tron_path_parse(source, text, (size_t)len, self->segs, self->keybuf);
+        return (PyObject *)self;
     }
 
-    Py_RETURN_NONE;
-}
-
-static PyObject *Tron_arr_append_bytes(TronObject *self, PyObject *args, PyObject *kwargs)
-{
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwlist, &value_obj, &ofs)) {
+    if (!PyList_Check(source) && !PyTuple_Check(source)) {
+        PyErr_Format(PyExc_TypeError, "path must be str, list or tuple, not %.200s", Py_TYPE(source)->tp_name);
         return NULL;
     }
 
-    Py_buffer view;
-    if (PyObject_GetBuffer(value_obj, &view, PyBUF_SIMPLE) < 0) {
+    /* A list is copied so the two passes below see the same segments. */
+    PyObject *seq = PySequence_Tuple(source);
+    if (!seq) {
         return NULL;
     }
+    Py_ssize_t count = PyTuple_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+    if (count == 0) {
+        PyErr_Format(PyExc_ValueError, "invalid path: %R", source);
+        goto error;
+    }
+
+    size_t keybuf_len = 0;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject *item = Py_IS_TYPE(items[i], &KeyType) ? ((KeyObject *)items[i])->name : items[i];
+        if (PyUnicode_Check(item)) {
+            const char *key = tron_key_from_py(item);
+            if (!key) {
+                goto error;
+            }
+            keybuf_len += strlen(key) + 1;
+        } else if (!PyLong_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "path segments must be str, tron.Key or int, not %.200s",
+                         Py_TYPE(item)->tp_name);
+            goto error;
+        }
+    }
 
-    int ret = lite3_ctx_arr_append_bytes(self->ctx, (size_t)ofs, (const unsigned char *)view.buf, (size_t)view.len);
-    PyBuffer_Release(&view);
-    if (ret < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_bytes");
+    self = (PathObject *)type->tp_alloc(type, count);
+    if (!self) {
+        goto error;
+    }
+    self->keybuf = PyMem_Malloc(keybuf_len + 1);
+    if (!self->keybuf) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    self->source = Py_NewRef(source);
+
+    char *out = self->keybuf;
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject *item = Py_IS_TYPE(items[i], &KeyType) ? ((KeyObject *)items[i])->name : items[i];
+        tron_path_seg *seg = &self->segs[i];
+        if (PyUnicode_Check(item)) {
+            const char *key = PyUnicode_AsUTF8(item);
+            size_t key_len = strlen(key);
+            memcpy(out, key, key_len + 1);
+            seg->key.key = out;
+            seg->key.key_data = lite3_get_key_data(out);
+            seg->index = 0;
+            out += key_len + 1;
+        } else {
+            unsigned long index = PyLong_AsUnsignedLong(item);
+            if (index == (unsigned long)-1 && PyErr_Occurred()) {
+                goto error;
+            }
+            if (index > UINT32_MAX) {
+                PyErr_SetString(PyExc_OverflowError, "array index out of range");
+                goto error;
+            }
+            seg->key.key = NULL;
+            seg->index = (uint32_t)index;
+        }
     }
 
-    Py_RETURN_NONE;
+    Py_DECREF(seq);
+    return (PyObject *)self;
+
+error:
+    Py_XDECREF(self);
+    Py_DECREF(seq);
+    return NULL;
 }
 
-static PyObject *Tron_arr_append_str(TronObject *self, PyObject *args, PyObject *kwargs)
+static PathObject *tron_path_from_arg(PyObject *obj)
 {
-    PyObject *value_obj = NULL;
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"value", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", kwlist, &value_obj, &ofs)) {
-        return NULL;
+    if (Py_IS_TYPE(obj, &PathType)) {
+        return (PathObject *)Py_NewRef(obj);
     }
+    return (PathObject *)tron_path_compile(&PathType, obj);
+}
 
-    Py_ssize_t value_len = 0;
-    const char *value = PyUnicode_AsUTF8AndSize(value_obj, &value_len);
-    if (!value) {
-        return NULL;
-    }
+/* Follows segs[0, count) from the container at ofs. On failure errno is set and
+ * *failed_at names the segment that could not be resolved. */
+static int tron_path_walk(lite3_ctx *ctx, size_t ofs, const tron_path_seg *segs, Py_ssize_t count,
+                          lite3_val **out, Py_ssize_t *failed_at)
+{
+    lite3_val *val = NULL;
 
-    if (lite3_ctx_arr_append_str_n(self->ctx, (size_t)ofs, value, (size_t)value_len) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_str_n");
+    for (Py_ssize_t i = 0; i < count; i++) {
+        if (i > 0) {
+            enum lite3_type type = lite3_val_type(val);
+            if (type != LITE3_TYPE_OBJECT && type != LITE3_TYPE_ARRAY) {
+                errno = EINVAL;
+                *failed_at = i;
+                return -1;
+            }
+            ofs = tron_val_ofs(ctx, val);
+        }
+
+        int ret = segs[i].key.key ? tron_ctx_get(ctx, ofs, &segs[i].key, &val)
+                                  : tron_ctx_arr_get(ctx, ofs, segs[i].index, &val);
+        if (ret < 0) {
+            *failed_at = i;
+            return -1;
+        }
     }
 
-    Py_RETURN_NONE;
+    *out = val;
+    return 0;
 }
 
-static PyObject *Tron_arr_append_obj(TronObject *self, PyObject *args, PyObject *kwargs)
+static PyObject *tron_raise_path(const PathObject *path, Py_ssize_t failed_at)
 {
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"ofs", NULL};
+    int err = errno;
+    PyErr_Format(TronError, "path %R: segment %zd: %s", path->source, failed_at,
+                 err ? strerror(err) : "lookup failed");
+    return NULL;
+}
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", kwlist, &ofs)) {
-        return NULL;
-    }
+/* tron_put_value() may call back into Python (a bytes subclass's __buffer__), and that
+ * code may mutate the container being walked: every entry is owned across the call, and
+ * list sizes are re-read on each step. The critical section keeps other threads out of the
+ * container on free-threaded builds; it can be suspended while a nested one is taken, which
+ * is why the strong references matter there too. */
+static int tron_fill_obj(lite3_ctx *ctx, size_t ofs, PyObject *mapping)
+{
+    PyObject *key_obj = NULL;
+    PyObject *value = NULL;
+    Py_ssize_t pos = 0;
+    int ret = 0;
 
-    size_t out_ofs = 0;
-    if (lite3_ctx_arr_append_obj(self->ctx, (size_t)ofs, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_obj");
+    Py_BEGIN_CRITICAL_SECTION(mapping);
+    while (ret == 0 && PyDict_Next(mapping, &pos, &key_obj, &value)) {
+        Py_INCREF(key_obj);
+        Py_INCREF(value);
+        tron_key key;
+        key.key = tron_key_from_py(key_obj);
+        if (!key.key) {
+            ret = -1;
+        } else {
+            key.key_data = lite3_get_key_data(key.key);
+            ret = tron_put_value(ctx, ofs, &key, value);
+        }
+        Py_DECREF(key_obj);
+        Py_DECREF(value);
     }
+    Py_END_CRITICAL_SECTION();
 
-    return PyLong_FromSize_t(out_ofs);
+    return ret;
 }
 
-static PyObject *Tron_arr_append_arr(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_fill_arr(lite3_ctx *ctx, size_t ofs, PyObject *seq)
 {
-    Py_ssize_t ofs = 0;
-    static char *kwlist[] = {"ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|n", kwlist, &ofs)) {
-        return NULL;
-    }
+    int ret = 0;
 
-    size_t out_ofs = 0;
-    if (lite3_ctx_arr_append_arr(self->ctx, (size_t)ofs, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_append_arr");
+    Py_BEGIN_CRITICAL_SECTION(seq);
+    for (Py_ssize_t i = 0; ret == 0 && i < PySequence_Fast_GET_SIZE(seq); i++) {
+        PyObject *item = Py_NewRef(PySequence_Fast_GET_ITEM(seq, i));
+        ret = tron_put_value(ctx, ofs, NULL, item);
+        Py_DECREF(item);
     }
+    Py_END_CRITICAL_SECTION();
 
-    return PyLong_FromSize_t(out_ofs);
+    return ret;
 }
 
-static PyObject *Tron_arr_get_bool(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_put_i64(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value)
 {
-    Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
-        return NULL;
+    long long number = PyLong_AsLongLong(value);
+    if (number == -1 && PyErr_Occurred()) {
+        return -1;
     }
 
-    bool value = false;
-    if (lite3_ctx_arr_get_bool(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_bool");
+    int ret = key ? tron_ctx_set_i64(ctx, ofs, key, (int64_t)number)
+                  : lite3_ctx_arr_append_i64(ctx, ofs, (int64_t)number);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_i64", "lite3_ctx_arr_append_i64");
     }
-
-    return PyBool_FromLong(value ? 1 : 0);
+    return 0;
 }
 
-static PyObject *Tron_arr_get_i64(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_put_f64(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value)
 {
-    Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
-        return NULL;
+    double number = PyFloat_AsDouble(value);
+    if (number == -1.0 && PyErr_Occurred()) {
+        return -1;
     }
 
-    int64_t value = 0;
-    if (lite3_ctx_arr_get_i64(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_i64");
+    int ret = key ? tron_ctx_set_f64(ctx, ofs, key, number)
+                  : lite3_ctx_arr_append_f64(ctx, ofs, number);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_f64", "lite3_ctx_arr_append_f64");
     }
-
-    return PyLong_FromLongLong((long long)value);
+    return 0;
 }
 
-static PyObject *Tron_arr_get_f64(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_put_str(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value)
 {
-    Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
-        return NULL;
+    Py_ssize_t len = 0;
+    const char *str = PyUnicode_AsUTF8AndSize(value, &len);
+    if (!str) {
+        return -1;
     }
 
-    double value = 0.0;
-    if (lite3_ctx_arr_get_f64(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_f64");
+    int ret = key ? tron_ctx_set_str(ctx, ofs, key, str, (size_t)len)
+                  : lite3_ctx_arr_append_str_n(ctx, ofs, str, (size_t)len);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_str_n", "lite3_ctx_arr_append_str_n");
     }
-
-    return PyFloat_FromDouble(value);
+    return 0;
 }
 
-static PyObject *Tron_arr_get_bytes(TronObject *self, PyObject *args, PyObject *kwargs)
+static int tron_put_bytes(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value)
 {
-    Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
+    Py_buffer view;
+    if (PyObject_GetBuffer(value, &view, PyBUF_SIMPLE) < 0) {
+        return -1;
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
-        return NULL;
+    /* A view of this very buffer (e.g. memoryview(tron)[a:b]) would dangle once growth reallocs. */
+    const unsigned char *bytes = (const unsigned char *)view.buf;
+    unsigned char *copy = NULL;
+    if (view.len > 0 && bytes >= ctx->buf && bytes < ctx->buf + ctx->bufsz) {
+        copy = PyMem_Malloc((size_t)view.len);
+        if (!copy) {
+            PyBuffer_Release(&view);
+            PyErr_NoMemory();
+            return -1;
+        }
+        memcpy(copy, bytes, (size_t)view.len);
+        bytes = copy;
     }
 
-    lite3_bytes value;
-    if (lite3_ctx_arr_get_bytes(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_bytes");
+    int ret = key ? tron_ctx_set_bytes(ctx, ofs, key, bytes, (size_t)view.len)
+                  : lite3_ctx_arr_append_bytes(ctx, ofs, bytes, (size_t)view.len);
+    PyMem_Free(copy);
+    PyBuffer_Release(&view);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_bytes", "lite3_ctx_arr_append_bytes");
     }
+    return 0;
+}
 
-    const unsigned char *bytes = LITE3_BYTES(self->ctx->buf, value);
-    if (!bytes) {
-        PyErr_SetString(TronError, "stale bytes reference");
+static int tron_put_null(lite3_ctx *ctx, size_t ofs, const tron_key *key)
+{
+    int ret = key ? tron_ctx_set_null(ctx, ofs, key) : lite3_ctx_arr_append_null(ctx, ofs);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_null", "lite3_ctx_arr_append_null");
+    }
+    return 0;
+}
+
+static int tron_put_bool(lite3_ctx *ctx, size_t ofs, const tron_key *key, bool value)
+{
+    int ret = key ? tron_ctx_set_bool(ctx, ofs, key, value) : lite3_ctx_arr_append_bool(ctx, ofs, value);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_ctx_set_bool", "lite3_ctx_arr_append_bool");
+    }
+    return 0;
+}
+
+static int tron_put_obj(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *mapping)
+{
+    size_t child_ofs = 0;
+    int ret = key ? tron_ctx_set_obj(ctx, ofs, key, &child_ofs) : lite3_ctx_arr_append_obj(ctx, ofs, &child_ofs);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_set_obj_impl", "lite3_ctx_arr_append_obj");
+    }
+
+    if (Py_EnterRecursiveCall(" while converting Python object to TRON")) {
+        return -1;
+    }
+    ret = tron_fill_obj(ctx, child_ofs, mapping);
+    Py_LeaveRecursiveCall();
+    return ret;
+}
+
+static int tron_put_arr(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *seq_obj)
+{
+    size_t child_ofs = 0;
+    int ret = key ? tron_ctx_set_arr(ctx, ofs, key, &child_ofs) : lite3_ctx_arr_append_arr(ctx, ofs, &child_ofs);
+    if (ret < 0) {
+        return tron_put_failed(key, "lite3_set_arr_impl", "lite3_ctx_arr_append_arr");
+    }
+
+    PyObject *seq = PySequence_Fast(seq_obj, "expected a list or tuple");
+    if (!seq) {
+        return -1;
+    }
+
+    if (Py_EnterRecursiveCall(" while converting Python object to TRON")) {
+        Py_DECREF(seq);
+        return -1;
+    }
+    ret = tron_fill_arr(ctx, child_ofs, seq);
+    Py_LeaveRecursiveCall();
+    Py_DECREF(seq);
+    return ret;
+}
+
+static int tron_put_value(lite3_ctx *ctx, size_t ofs, const tron_key *key, PyObject *value)
+{
+    /* Exact builtin types first: no MRO walk and no subclass surprises. */
+    if (PyUnicode_CheckExact(value)) {
+        return tron_put_str(ctx, ofs, key, value);
+    }
+    if (PyLong_CheckExact(value)) {
+        return tron_put_i64(ctx, ofs, key, value);
+    }
+    if (PyFloat_CheckExact(value)) {
+        return tron_put_f64(ctx, ofs, key, value);
+    }
+    if (value == Py_None) {
+        return tron_put_null(ctx, ofs, key);
+    }
+    if (value == Py_True || value == Py_False) {
+        return tron_put_bool(ctx, ofs, key, value == Py_True);
+    }
+    if (PyDict_CheckExact(value)) {
+        return tron_put_obj(ctx, ofs, key, value);
+    }
+    if (PyList_CheckExact(value) || PyTuple_CheckExact(value)) {
+        return tron_put_arr(ctx, ofs, key, value);
+    }
+    if (PyBytes_CheckExact(value)) {
+        return tron_put_bytes(ctx, ofs, key, value);
+    }
+
+    /* Subclasses, in the same order as the isinstance chain in tron/py.py. */
+    if (PyLong_Check(value)) {
+        return tron_put_i64(ctx, ofs, key, value);
+    }
+    if (PyFloat_Check(value)) {
+        return tron_put_f64(ctx, ofs, key, value);
+    }
+    if (PyUnicode_Check(value)) {
+        return tron_put_str(ctx, ofs, key, value);
+    }
+    if (PyBytes_Check(value) || PyByteArray_Check(value) || PyMemoryView_Check(value)) {
+        return tron_put_bytes(ctx, ofs, key, value);
+    }
+    if (PyDict_Check(value)) {
+        return tron_put_obj(ctx, ofs, key, value);
+    }
+    if (PyList_Check(value) || PyTuple_Check(value)) {
+        return tron_put_arr(ctx, ofs, key, value);
+    }
+
+    PyErr_Format(PyExc_TypeError, "unsupported value type: %R", (PyObject *)Py_TYPE(value));
+    return -1;
+}
+
+/* Fails exactly where tron_put_value() would for a reason other than lite3 itself, without
+ * writing anything: lets a batch be rejected before its first record lands. */
+static int tron_check_value(PyObject *value)
+{
+    if (value == Py_None || value == Py_True || value == Py_False || PyFloat_Check(value)) {
+        return 0;
+    }
+    if (PyLong_Check(value)) {
+        long long number = PyLong_AsLongLong(value);
+        return number == -1 && PyErr_Occurred() ? -1 : 0;
+    }
+    if (PyUnicode_Check(value)) {
+        return PyUnicode_AsUTF8AndSize(value, NULL) ? 0 : -1;
+    }
+    if (PyBytes_Check(value) || PyByteArray_Check(value) || PyMemoryView_Check(value)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(value, &view, PyBUF_SIMPLE) < 0) {
+            return -1;
+        }
+        PyBuffer_Release(&view);
+        return 0;
+    }
+    if (!PyDict_Check(value) && !PyList_Check(value) && !PyTuple_Check(value)) {
+        PyErr_Format(PyExc_TypeError, "unsupported value type: %R", (PyObject *)Py_TYPE(value));
+        return -1;
+    }
+
+    if (Py_EnterRecursiveCall(" while converting Python object to TRON")) {
+        return -1;
+    }
+    /* Walked like tron_fill_obj()/tron_fill_arr(): the buffer check above runs Python code. */
+    int ret = 0;
+    Py_BEGIN_CRITICAL_SECTION(value);
+    if (PyDict_Check(value)) {
+        PyObject *key_obj = NULL;
+        PyObject *item = NULL;
+        Py_ssize_t pos = 0;
+        while (ret == 0 && PyDict_Next(value, &pos, &key_obj, &item)) {
+            Py_INCREF(key_obj);
+            Py_INCREF(item);
+            ret = tron_key_from_py(key_obj) && tron_check_value(item) == 0 ? 0 : -1;
+            Py_DECREF(key_obj);
+            Py_DECREF(item);
+        }
+    } else {
+        for (Py_ssize_t i = 0; ret == 0 && i < PySequence_Fast_GET_SIZE(value); i++) {
+            PyObject *item = Py_NewRef(PySequence_Fast_GET_ITEM(value, i));
+            ret = tron_check_value(item);
+            Py_DECREF(item);
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    Py_LeaveRecursiveCall();
+    return ret;
+}
+
+/* Per-entry bookkeeping on top of the key and payload bytes (node slot, tag, length). */
+#define TRON_ENTRY_OVERHEAD 16
+#define TRON_ESTIMATE_DEPTH 32
+
+/* Rough encoded size of value, nested nodes included. Only used to grow once up front:
+ * an underestimate just means lite3 grows again on its own. */
+static size_t tron_estimate_value(PyObject *value, int depth)
+{
+    if (PyUnicode_Check(value)) {
+        return TRON_ENTRY_OVERHEAD + (size_t)PyUnicode_GET_LENGTH(value) * PyUnicode_KIND(value);
+    }
+    if (PyBytes_Check(value)) {
+        return TRON_ENTRY_OVERHEAD + (size_t)PyBytes_GET_SIZE(value);
+    }
+    if (PyByteArray_Check(value)) {
+        return TRON_ENTRY_OVERHEAD + (size_t)PyByteArray_GET_SIZE(value);
+    }
+    if (depth >= TRON_ESTIMATE_DEPTH) {
+        return LITE3_NODE_SIZE;
+    }
+    if (!PyDict_Check(value) && !PyList_Check(value) && !PyTuple_Check(value)) {
+        return TRON_ENTRY_OVERHEAD;
+    }
+
+    /* Nested critical sections may suspend this one, so entries are held while recursing. */
+    size_t size = LITE3_NODE_SIZE;
+    Py_BEGIN_CRITICAL_SECTION(value);
+    if (PyDict_Check(value)) {
+        PyObject *key_obj = NULL;
+        PyObject *item = NULL;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(value, &pos, &key_obj, &item)) {
+            size += PyUnicode_Check(key_obj) ? (size_t)PyUnicode_GET_LENGTH(key_obj) + 1 : 0;
+            Py_INCREF(item);
+            size += tron_estimate_value(item, depth + 1);
+            Py_DECREF(item);
+        }
+    } else {
+        for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(value); i++) {
+            PyObject *item = Py_NewRef(PySequence_Fast_GET_ITEM(value, i));
+            size += tron_estimate_value(item, depth + 1);
+            Py_DECREF(item);
+        }
+    }
+    Py_END_CRITICAL_SECTION();
+    return size;
+}
+
+/* Makes room for extra more bytes up front through lite3's own grow step, so the inserts
+ * that follow never stop to grow. Callers must have passed tron_check_mutable(), since the
+ * buffer moves. */
+static int tron_reserve(TronObject *self, size_t extra)
+{
+    lite3_ctx *ctx = self->ctx;
+    if (extra > LITE3_BUF_SIZE_MAX - ctx->buflen) {
+        return 0; /* leave it to lite3 to report the overflow */
+    }
+
+    while (extra > ctx->bufsz - ctx->buflen) {
+        size_t bufsz = ctx->bufsz;
+        errno = 0;
+        if (lite3_ctx_grow_impl(ctx) < 0 || ctx->bufsz <= bufsz) {
+            tron_raise_errno("lite3_ctx_grow_impl");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Builds the new ctx before touching the old one, so a failed re-init leaves self as it was. */
+static int tron_setup(TronObject *self, const char *root, Py_ssize_t bufsz)
+{
+    if (self->ctx && tron_is_frozen(self)) {
+        PyErr_SetString(TronError, "cannot reinitialize a read-only Tron");
+        return -1;
+    }
+    bool is_obj = strcmp(root, "object") == 0;
+    if (!is_obj && strcmp(root, "array") != 0) {
+        PyErr_SetString(PyExc_ValueError, "root must be 'object' or 'array'");
+        return -1;
+    }
+
+    lite3_ctx *ctx = bufsz > 0 ? lite3_ctx_create_with_size((size_t)bufsz) : lite3_ctx_create();
+    if (!ctx) {
+        tron_raise_errno("lite3_ctx_create");
+        return -1;
+    }
+    if ((is_obj ? lite3_ctx_init_obj(ctx) : lite3_ctx_init_arr(ctx)) < 0) {
+        tron_raise_errno("lite3_ctx_init");
+        lite3_ctx_destroy(ctx);
+        return -1;
+    }
+
+    if (!self->ctx) {
+        self->ctx = ctx;
+        return 0;
+    }
+
+    /* A write further up this thread's stack still holds pointers into the old ctx. */
+    if (tron_lock_held(self)) {
+        lite3_ctx_destroy(ctx);
+        PyErr_SetString(PyExc_BufferError, "cannot reinitialize Tron while it is being modified");
+        return -1;
+    }
+    tron_lock(self);
+    if (self->exports > 0) {
+        tron_unlock(self);
+        lite3_ctx_destroy(ctx);
+        PyErr_SetString(PyExc_BufferError, "cannot modify Tron while its buffer is exported");
+        return -1;
+    }
+    self->version++;
+    tron_release_ctx(self);
+    self->ctx = ctx;
+    tron_unlock(self);
+    return 0;
+}
+
+static int Tron_init(TronObject *self, PyObject *args, PyObject *kwargs)
+{
+    const char *root = "object";
+    Py_ssize_t bufsz = 0;
+    static char *kwlist[] = {"root", "bufsz", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|sn", kwlist, &root, &bufsz)) {
+        return -1;
+    }
+
+    int ret = 0;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    ret = tron_setup(self, root, bufsz);
+    Py_END_CRITICAL_SECTION();
+    return ret;
+}
+
+/* Tron(...) without the tp_new/tp_init tuple round-trip; Tron_init remains for __init__(). */
+static PyObject *Tron_vectorcall(PyObject *type, PyObject *const *args, size_t nargsf, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "Tron", 0, "root", "bufsz");
+    PyObject *argv[2];
+    const char *root = "object";
+    Py_ssize_t bufsz = 0;
+
+    if (tron_parse_args(&parser, args, PyVectorcall_NARGS(nargsf), kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_cstr(argv[0], &root) < 0 || tron_arg_ssize(argv[1], &bufsz) < 0) {
         return NULL;
     }
 
-    return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)value.len);
+    PyTypeObject *tp = (PyTypeObject *)type;
+    TronObject *self = (TronObject *)tp->tp_alloc(tp, 0);
+    if (!self) {
+        return NULL;
+    }
+    if (tron_setup(self, root, bufsz) < 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
 }
 
-static PyObject *Tron_arr_get_str(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Hands a pooled Tron's ctx back to its Pool; the Tron is unusable afterwards. The lock is
+ * taken before exports is checked, so no reader can export the buffer in between. */
+static int tron_pool_release(TronObject *self)
 {
-    Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
+    if (!self->pool) {
+        return 0;
+    }
+    if (tron_lock_held(self)) {
+        PyErr_SetString(PyExc_BufferError, "cannot release Tron while it is being modified");
+        return -1;
+    }
+    tron_lock(self);
+    if (self->exports > 0) {
+        tron_unlock(self);
+        PyErr_SetString(PyExc_BufferError, "cannot release Tron while its buffer is exported");
+        return -1;
+    }
+
+    self->version++;
+    lite3_ctx *ctx = self->ctx;
+    PyObject *pool = self->pool;
+    self->ctx = NULL;
+    self->pool = NULL;
+    tron_unlock(self);
+    if (ctx) {
+        tron_pool_put(pool, ctx);
+    }
+    Py_DECREF(pool);
+    return 0;
+}
+
+static void Tron_dealloc(TronObject *self)
+{
+    if (self->pool) {
+        tron_pool_release(self);
+    }
+    tron_release_ctx(self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int Tron_getbuffer(TronObject *self, Py_buffer *view, int flags)
+{
+    int ret = -1;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (!self->ctx) {
+        tron_raise_released();
+    } else if (tron_lock_held(self)) {
+        /* A Python callback in the middle of this thread's own write. */
+        PyErr_SetString(PyExc_BufferError, "cannot export Tron buffer while it is being modified");
+    } else {
+        /* Taken so the export cannot land between a writer's exports check and its grow. */
+        tron_read_begin(self);
+        if (self->ctx) {
+            ret = PyBuffer_FillInfo(view, (PyObject *)self, self->ctx->buf, (Py_ssize_t)self->ctx->buflen, 1, flags);
+        } else {
+            tron_raise_released();
+        }
+        if (ret == 0) {
+            self->exports++;
+        }
+        tron_read_end(self);
+    }
+    Py_END_CRITICAL_SECTION();
+    return ret;
+}
+
+static void Tron_releasebuffer(TronObject *self, Py_buffer *Py_UNUSED(view))
+{
+    Py_BEGIN_CRITICAL_SECTION(self);
+    self->exports--;
+    Py_END_CRITICAL_SECTION();
+}
+
+static PyBufferProcs Tron_as_buffer = {
+    .bf_getbuffer = (getbufferproc)Tron_getbuffer,
+    .bf_releasebuffer = (releasebufferproc)Tron_releasebuffer,
+};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
+static PyObject *Tron_init_obj(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    if (tron_check_mutable(self) < 0) {
         return NULL;
     }
 
-    lite3_str value;
-    if (lite3_ctx_arr_get_str(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_str");
+    if (lite3_ctx_init_obj(self->ctx) < 0) {
+        return tron_raise_errno("lite3_ctx_init_obj");
     }
+    Py_RETURN_NONE;
+}
 
-    const char *str = LITE3_STR(self->ctx->buf, value);
-    if (!str) {
-        PyErr_SetString(TronError, "stale string reference");
+static PyObject *Tron_init_arr(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    if (tron_check_mutable(self) < 0) {
         return NULL;
     }
 
-    return PyUnicode_FromStringAndSize(str, (Py_ssize_t)value.len);
+    if (lite3_ctx_init_arr(self->ctx) < 0) {
+        return tron_raise_errno("lite3_ctx_init_arr");
+    }
+    Py_RETURN_NONE;
+}
+
+/* Re-initializes the root in place: buflen drops to the empty root, bufsz is kept. */
+static PyObject *Tron_reset(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "reset", 0, "root");
+    PyObject *argv[1];
+    const char *root = "object";
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_cstr(argv[0], &root) < 0) {
+        return NULL;
+    }
+
+    bool is_obj = strcmp(root, "object") == 0;
+    if (!is_obj && strcmp(root, "array") != 0) {
+        PyErr_SetString(PyExc_ValueError, "root must be 'object' or 'array'");
+        return NULL;
+    }
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+    if ((is_obj ? lite3_ctx_init_obj(self->ctx) : lite3_ctx_init_arr(self->ctx)) < 0) {
+        return tron_raise_errno("lite3_ctx_init");
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_enter(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    return Py_NewRef(self);
+}
+
+static PyObject *Tron_exit(TronObject *self, PyObject *const *Py_UNUSED(args), Py_ssize_t Py_UNUSED(nargs))
+{
+    int ret = 0;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    ret = tron_pool_release(self);
+    Py_END_CRITICAL_SECTION();
+    if (ret < 0) {
+        return NULL;
+    }
+    Py_RETURN_FALSE;
 }
 
-static PyObject *Tron_arr_get_obj(TronObject *self, PyObject *args, PyObject *kwargs)
+static PyObject *Tron_set_null(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
+    TRON_ARGPARSER(parser, "set_null", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
     Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
         return NULL;
     }
 
-    size_t out_ofs = 0;
-    if (lite3_ctx_arr_get_obj(self->ctx, (size_t)ofs, (uint32_t)index, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_obj");
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
     }
 
-    return PyLong_FromSize_t(out_ofs);
+    if (tron_put_null(self->ctx, (size_t)ofs, &key) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
 }
 
-static PyObject *Tron_arr_get_arr(TronObject *self, PyObject *args, PyObject *kwargs)
+static PyObject *Tron_set_bool(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
+    TRON_ARGPARSER(parser, "set_bool", 2, "key", "value", "ofs");
+    PyObject *argv[3];
+    tron_key key;
+    PyObject *value_obj = NULL;
     Py_ssize_t ofs = 0;
-    unsigned long index = 0;
-    static char *kwlist[] = {"index", "ofs", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "k|n", kwlist, &index, &ofs)) {
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[1];
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[2], &ofs) < 0) {
         return NULL;
     }
 
-    size_t out_ofs = 0;
-    if (lite3_ctx_arr_get_arr(self->ctx, (size_t)ofs, (uint32_t)index, &out_ofs) < 0) {
-        return tron_raise_errno("lite3_ctx_arr_get_arr");
+    int truth = PyObject_IsTrue(value_obj);
+    if (truth < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
     }
 
-    return PyLong_FromSize_t(out_ofs);
+    if (tron_put_bool(self->ctx, (size_t)ofs, &key, truth != 0) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_set_i64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_i64", 2, "key", "value", "ofs");
+    PyObject *argv[3];
+    tron_key key;
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[1];
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[2], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (tron_put_i64(self->ctx, (size_t)ofs, &key, value_obj) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_set_f64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_f64", 2, "key", "value", "ofs");
+    PyObject *argv[3];
+    tron_key key;
+    double value = 0.0;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 ||
+        tron_arg_f64(argv[1], &value) < 0 ||
+        tron_arg_ssize(argv[2], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (tron_ctx_set_f64(self->ctx, (size_t)ofs, &key, value) < 0) {
+        return tron_raise_errno("lite3_ctx_set_f64");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_set_bytes(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_bytes", 2, "key", "value", "ofs");
+    PyObject *argv[3];
+    tron_key key;
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[1];
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[2], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (tron_put_bytes(self->ctx, (size_t)ofs, &key, value_obj) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_set_str(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_str", 2, "key", "value", "ofs");
+    PyObject *argv[3];
+    tron_key key;
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[1];
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[2], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (tron_put_str(self->ctx, (size_t)ofs, &key, value_obj) < 0) {
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_set_obj(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_obj", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (tron_ctx_set_obj(self->ctx, (size_t)ofs, &key, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_set_obj_impl");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *Tron_set_arr(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_arr", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (tron_ctx_set_arr(self->ctx, (size_t)ofs, &key, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_set_arr_impl");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *Tron_get_bool(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_bool", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_BOOL, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_bool");
+    }
+
+    if (lite3_val_bool(val)) {
+        Py_RETURN_TRUE;
+    }
+    Py_RETURN_FALSE;
+}
+
+static PyObject *Tron_get_i64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_i64", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_I64, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_i64");
+    }
+
+    return PyLong_FromLongLong((long long)lite3_val_i64(val));
+}
+
+static PyObject *Tron_get_f64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_f64", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_F64, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_f64");
+    }
+
+    return PyFloat_FromDouble(lite3_val_f64(val));
+}
+
+static PyObject *Tron_get_bytes(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_bytes", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_BYTES, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_bytes");
+    }
+
+    size_t len = 0;
+    const unsigned char *bytes = lite3_val_bytes(val, &len);
+    return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)len);
+}
+
+static PyObject *Tron_get_str(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_str", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_STRING, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_str");
+    }
+
+    size_t len = 0;
+    const char *str = lite3_val_str_n(val, &len);
+    return PyUnicode_FromStringAndSize(str, (Py_ssize_t)len);
+}
+
+static PyObject *Tron_get_obj(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_obj", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_OBJECT, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_obj");
+    }
+
+    return PyLong_FromSize_t(tron_val_ofs(self->ctx, val));
+}
+
+static PyObject *Tron_get_arr(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_arr", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get_typed(self->ctx, (size_t)ofs, &key, LITE3_TYPE_ARRAY, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_arr");
+    }
+
+    return PyLong_FromSize_t(tron_val_ofs(self->ctx, val));
+}
+
+static const char *tron_type_name(enum lite3_type type)
+{
+    switch (type) {
+    case LITE3_TYPE_NULL:
+        return "null";
+    case LITE3_TYPE_BOOL:
+        return "bool";
+    case LITE3_TYPE_I64:
+        return "i64";
+    case LITE3_TYPE_F64:
+        return "f64";
+    case LITE3_TYPE_BYTES:
+        return "bytes";
+    case LITE3_TYPE_STRING:
+        return "string";
+    case LITE3_TYPE_OBJECT:
+        return "object";
+    case LITE3_TYPE_ARRAY:
+        return "array";
+    default:
+        return "unknown";
+    }
+}
+
+static PyObject *Tron_get_type(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_type", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get(self->ctx, (size_t)ofs, &key, &val) < 0) {
+        return tron_raise_errno("lite3_ctx_get_type");
+    }
+
+    return PyUnicode_FromString(tron_type_name(lite3_val_type(val)));
+}
+
+static PyObject *Tron_get(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get(self->ctx, (size_t)ofs, &key, &val) < 0) {
+        return tron_raise_errno("lite3_get_impl");
+    }
+
+    return tron_val_to_py(self->ctx, val);
+}
+
+static PyObject *Tron_exists(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "exists", 1, "key", "ofs");
+    PyObject *argv[2];
+    tron_key key;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_key(argv[0], &key) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_get(self->ctx, (size_t)ofs, &key, &val) == 0) {
+        Py_RETURN_TRUE;
+    }
+    Py_RETURN_FALSE;
+}
+
+static PyObject *Tron_get_path(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_path", 1, "path", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    PathObject *path = tron_path_from_arg(argv[0]);
+    if (!path) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    Py_ssize_t failed_at = 0;
+    PyObject *result = NULL;
+    if (tron_path_walk(self->ctx, (size_t)ofs, path->segs, Py_SIZE(path), &val, &failed_at) < 0) {
+        tron_raise_path(path, failed_at);
+    } else {
+        result = tron_val_to_py(self->ctx, val);
+    }
+
+    Py_DECREF(path);
+    return result;
+}
+
+/* Missing intermediate keys are created as objects; the last segment must be a key. */
+static PyObject *Tron_set_path(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_path", 2, "path", "value", "ofs");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[2], &ofs) < 0) {
+        return NULL;
+    }
+
+    PathObject *path = tron_path_from_arg(argv[0]);
+    if (!path) {
+        return NULL;
+    }
+
+    Py_ssize_t last = Py_SIZE(path) - 1;
+    if (!path->segs[last].key.key) {
+        PyErr_Format(PyExc_ValueError, "set_path: last segment of %R must be a key", path->source);
+        goto error;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        goto error;
+    }
+
+    size_t cur = (size_t)ofs;
+    for (Py_ssize_t i = 0; i < last; i++) {
+        const tron_path_seg *seg = &path->segs[i];
+        lite3_val *val = NULL;
+        int ret = seg->key.key ? tron_ctx_get(self->ctx, cur, &seg->key, &val)
+                               : tron_ctx_arr_get(self->ctx, cur, seg->index, &val);
+        if (ret < 0 && seg->key.key && errno == ENOENT) {
+            if (tron_ctx_set_obj(self->ctx, cur, &seg->key, &cur) < 0) {
+                tron_raise_path(path, i);
+                goto error;
+            }
+            continue;
+        }
+        if (ret == 0 && lite3_val_type(val) != LITE3_TYPE_OBJECT && lite3_val_type(val) != LITE3_TYPE_ARRAY) {
+            errno = EINVAL;
+            ret = -1;
+        }
+        if (ret < 0) {
+            tron_raise_path(path, i);
+            goto error;
+        }
+        cur = tron_val_ofs(self->ctx, val);
+    }
+
+    if (tron_put_value(self->ctx, cur, &path->segs[last].key, argv[1]) < 0) {
+        goto error;
+    }
+
+    Py_DECREF(path);
+    Py_RETURN_NONE;
+
+error:
+    Py_DECREF(path);
+    return NULL;
+}
+
+static PyObject *Tron_get_many(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get_many", 1, "keys", "ofs", "default", "as_dict");
+    PyObject *argv[4];
+    Py_ssize_t ofs = 0;
+    int as_dict = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0 || tron_arg_bool(argv[3], &as_dict) < 0) {
+        return NULL;
+    }
+    PyObject *default_obj = argv[2] ? argv[2] : Py_None;
+
+    /* A lone key would otherwise be split into one-character keys. */
+    if (PyUnicode_Check(argv[0]) || PyBytes_Check(argv[0]) || PyByteArray_Check(argv[0])) {
+        PyErr_Format(PyExc_TypeError, "keys must be a sequence of str or tron.Key, not %T", argv[0]);
+        return NULL;
+    }
+    PyObject *seq = tron_arg_items(argv[0], "keys must be a sequence of str or tron.Key");
+    if (!seq) {
+        return NULL;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+
+    PyObject *result = as_dict ? PyDict_New() : PyTuple_New(count);
+    if (!result) {
+        goto error;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        tron_key key;
+        if (tron_arg_key(items[i], &key) < 0) {
+            goto error;
+        }
+
+        PyObject *value = NULL;
+        lite3_val *val = NULL;
+        errno = 0;
+        if (tron_ctx_get(self->ctx, (size_t)ofs, &key, &val) == 0) {
+            value = tron_val_to_py(self->ctx, val);
+        } else if (errno == ENOENT) {
+            value = Py_NewRef(default_obj);
+        } else {
+            tron_raise_errno("lite3_get_impl");
+        }
+        if (!value) {
+            goto error;
+        }
+
+        if (as_dict) {
+            PyObject *name = Py_IS_TYPE(items[i], &KeyType) ? ((KeyObject *)items[i])->name : items[i];
+            int ret = PyDict_SetItem(result, name, value);
+            Py_DECREF(value);
+            if (ret < 0) {
+                goto error;
+            }
+        } else {
+            PyTuple_SET_ITEM(result, i, value);
+        }
+    }
+
+    Py_DECREF(seq);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    Py_DECREF(seq);
+    return NULL;
+}
+
+static PyObject *Tron_extract(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "extract", 1, "spec", "ofs", "default");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+    PyObject *default_obj = argv[2] ? argv[2] : Py_None;
+
+    PyObject *seq = tron_arg_items(argv[0], "spec must be a sequence of paths");
+    if (!seq) {
+        return NULL;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject **items = PySequence_Fast_ITEMS(seq);
+
+    PyObject *result = PyTuple_New(count);
+    if (!result) {
+        goto error;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PathObject *path = tron_path_from_arg(items[i]);
+        if (!path) {
+            goto error;
+        }
+
+        PyObject *value = NULL;
+        lite3_val *val = NULL;
+        Py_ssize_t failed_at = 0;
+        errno = 0;
+        if (tron_path_walk(self->ctx, (size_t)ofs, path->segs, Py_SIZE(path), &val, &failed_at) == 0) {
+            value = tron_val_to_py(self->ctx, val);
+        } else if (errno == ENOENT) {
+            value = Py_NewRef(default_obj);
+        } else {
+            tron_raise_path(path, failed_at);
+        }
+        Py_DECREF(path);
+        if (!value) {
+            goto error;
+        }
+        PyTuple_SET_ITEM(result, i, value);
+    }
+
+    Py_DECREF(seq);
+    return result;
+
+error:
+    Py_XDECREF(result);
+    Py_DECREF(seq);
+    return NULL;
+}
+
+static PyObject *Tron_set_many(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "set_many", 1, "items", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    /* Flatten into owned key/value references first: the size estimate and the inserts
+     * walk the same data, each key is hashed once, and value conversion calling back
+     * into Python cannot pull items out from under us. */
+    PyObject *items = argv[0];
+    PyObject *pairs = NULL;
+    PyObject *result = NULL;
+    Py_ssize_t count = 0;
+    Py_ssize_t owned = 0;
+    tron_key *keys = NULL;
+    PyObject **refs = NULL;
+    if (PyDict_Check(items)) {
+        /* Nothing in here runs Python code, so the dict holds still for the whole copy. */
+        Py_BEGIN_CRITICAL_SECTION(items);
+        count = PyDict_GET_SIZE(items);
+        refs = PyMem_New(PyObject *, (size_t)count * 2);
+        PyObject *key_obj = NULL;
+        PyObject *value = NULL;
+        Py_ssize_t pos = 0;
+        while (refs && owned < count && PyDict_Next(items, &pos, &key_obj, &value)) {
+            refs[2 * owned] = Py_NewRef(key_obj);
+            refs[2 * owned + 1] = Py_NewRef(value);
+            owned++;
+        }
+        Py_END_CRITICAL_SECTION();
+    } else {
+        pairs = tron_arg_items(items, "set_many() expects a dict or an iterable of (key, value) pairs");
+        if (!pairs) {
+            return NULL;
+        }
+        count = PySequence_Fast_GET_SIZE(pairs);
+        refs = PyMem_New(PyObject *, (size_t)count * 2);
+        for (Py_ssize_t i = 0; refs && i < count; i++) {
+            PyObject *pair = PySequence_Fast_GET_ITEM(pairs, i);
+            if (!PyTuple_Check(pair) && !PyList_Check(pair)) {
+                PyErr_Format(PyExc_TypeError, "set_many() item %zd is not a (key, value) pair", i);
+                goto done;
+            }
+            Py_ssize_t pair_len = 0;
+            Py_BEGIN_CRITICAL_SECTION(pair);
+            pair_len = PySequence_Fast_GET_SIZE(pair);
+            if (pair_len == 2) {
+                refs[2 * i] = Py_NewRef(PySequence_Fast_GET_ITEM(pair, 0));
+                refs[2 * i + 1] = Py_NewRef(PySequence_Fast_GET_ITEM(pair, 1));
+                owned = i + 1;
+            }
+            Py_END_CRITICAL_SECTION();
+            if (pair_len != 2) {
+                PyErr_Format(PyExc_ValueError, "set_many() item %zd has length %zd; 2 is required", i, pair_len);
+                goto done;
+            }
+        }
+    }
+
+    keys = PyMem_New(tron_key, (size_t)count);
+    if (!keys || !refs) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    size_t estimate = 0;
+    for (Py_ssize_t i = 0; i < owned; i++) {
+        if (tron_arg_key(refs[2 * i], &keys[i]) < 0) {
+            goto done;
+        }
+        estimate += TRON_ENTRY_OVERHEAD + keys[i].key_data.size + tron_estimate_value(refs[2 * i + 1], 0);
+    }
+
+    if (tron_check_mutable(self) < 0 || tron_reserve(self, estimate) < 0) {
+        goto done;
+    }
+
+    for (Py_ssize_t i = 0; i < owned; i++) {
+        if (tron_put_value(self->ctx, (size_t)ofs, &keys[i], refs[2 * i + 1]) < 0) {
+            goto done;
+        }
+    }
+
+    result = Py_None;
+
+done:
+    for (Py_ssize_t i = 0; i < owned * 2; i++) {
+        Py_DECREF(refs[i]);
+    }
+    PyMem_Free(keys);
+    PyMem_Free(refs);
+    Py_XDECREF(pairs);
+    return Py_XNewRef(result);
+}
+
+static PyObject *Tron_arr_append_null(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_null", 0, "ofs");
+    PyObject *argv[1];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (lite3_ctx_arr_append_null(self->ctx, (size_t)ofs) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_null");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_bool(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_bool", 1, "value", "ofs");
+    PyObject *argv[2];
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[0];
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    int truth = PyObject_IsTrue(value_obj);
+    if (truth < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (lite3_ctx_arr_append_bool(self->ctx, (size_t)ofs, truth != 0) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_bool");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_i64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_i64", 1, "value", "ofs");
+    PyObject *argv[2];
+    int64_t value = 0;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_i64(argv[0], &value) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (lite3_ctx_arr_append_i64(self->ctx, (size_t)ofs, value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_i64");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_f64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_f64", 1, "value", "ofs");
+    PyObject *argv[2];
+    double value = 0.0;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_f64(argv[0], &value) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    if (lite3_ctx_arr_append_f64(self->ctx, (size_t)ofs, value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_f64");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_bytes(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_bytes", 1, "value", "ofs");
+    PyObject *argv[2];
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[0];
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(value_obj, &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    int ret = lite3_ctx_arr_append_bytes(self->ctx, (size_t)ofs, (const unsigned char *)view.buf, (size_t)view.len);
+    PyBuffer_Release(&view);
+    if (ret < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_bytes");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_str(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_str", 1, "value", "ofs");
+    PyObject *argv[2];
+    PyObject *value_obj = NULL;
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    value_obj = argv[0];
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    Py_ssize_t value_len = 0;
+    const char *value = PyUnicode_AsUTF8AndSize(value_obj, &value_len);
+    if (!value) {
+        return NULL;
+    }
+
+    if (lite3_ctx_arr_append_str_n(self->ctx, (size_t)ofs, value, (size_t)value_len) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_str_n");
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_append_obj(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_obj", 0, "ofs");
+    PyObject *argv[1];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (lite3_ctx_arr_append_obj(self->ctx, (size_t)ofs, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_obj");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *Tron_arr_append_arr(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_append_arr", 0, "ofs");
+    PyObject *argv[1];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (lite3_ctx_arr_append_arr(self->ctx, (size_t)ofs, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_append_arr");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *Tron_arr_get_bool(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_bool", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    bool value = false;
+    if (lite3_ctx_arr_get_bool(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_bool");
+    }
+
+    return PyBool_FromLong(value ? 1 : 0);
+}
+
+static PyObject *Tron_arr_get_i64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_i64", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    int64_t value = 0;
+    if (lite3_ctx_arr_get_i64(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_i64");
+    }
+
+    return PyLong_FromLongLong((long long)value);
+}
+
+static PyObject *Tron_arr_get_f64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_f64", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    double value = 0.0;
+    if (lite3_ctx_arr_get_f64(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_f64");
+    }
+
+    return PyFloat_FromDouble(value);
+}
+
+static PyObject *Tron_arr_get_bytes(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_bytes", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_bytes value;
+    if (lite3_ctx_arr_get_bytes(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_bytes");
+    }
+
+    const unsigned char *bytes = LITE3_BYTES(self->ctx->buf, value);
+    if (!bytes) {
+        PyErr_SetString(TronError, "stale bytes reference");
+        return NULL;
+    }
+
+    return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)value.len);
+}
+
+static PyObject *Tron_arr_get_str(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_str", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    lite3_str value;
+    if (lite3_ctx_arr_get_str(self->ctx, (size_t)ofs, (uint32_t)index, &value) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_str");
+    }
+
+    const char *str = LITE3_STR(self->ctx->buf, value);
+    if (!str) {
+        PyErr_SetString(TronError, "stale string reference");
+        return NULL;
+    }
+
+    return PyUnicode_FromStringAndSize(str, (Py_ssize_t)value.len);
+}
+
+static PyObject *Tron_arr_get_obj(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_obj", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (lite3_ctx_arr_get_obj(self->ctx, (size_t)ofs, (uint32_t)index, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_obj");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *Tron_arr_get_arr(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_get_arr", 1, "index", "ofs");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    unsigned long index = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ulong(argv[0], &index) < 0 || tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    size_t out_ofs = 0;
+    if (lite3_ctx_arr_get_arr(self->ctx, (size_t)ofs, (uint32_t)index, &out_ofs) < 0) {
+        return tron_raise_errno("lite3_ctx_arr_get_arr");
+    }
+
+    return PyLong_FromSize_t(out_ofs);
+}
+
+static PyObject *tron_import_attr(const char *module_name, const char *attr)
+{
+    PyObject *module = PyImport_ImportModule(module_name);
+    if (!module) {
+        return NULL;
+    }
+    PyObject *value = PyObject_GetAttrString(module, attr);
+    Py_DECREF(module);
+    return value;
+}
+
+/* Single struct code of a buffer's format, with the native-order prefixes ('@', '=', and
+ * '<' on little-endian hosts) stripped; 0 for anything else. */
+static char tron_buffer_code(const Py_buffer *view)
+{
+    const char *fmt = view->format ? view->format : "B";
+    if (*fmt == '@' || *fmt == '=' || (PY_LITTLE_ENDIAN && *fmt == '<')) {
+        fmt++;
+    }
+    return fmt[0] && !fmt[1] ? fmt[0] : 0;
+}
+
+static int tron_check_arr(const lite3_ctx *ctx, Py_ssize_t ofs)
+{
+    if (ofs < 0 || (size_t)ofs >= ctx->buflen ||
+        lite3_val_type((const lite3_val *)(ctx->buf + ofs)) != LITE3_TYPE_ARRAY) {
+        PyErr_SetString(TronError, "offset does not point to an array");
+        return -1;
+    }
+    return 0;
+}
+
+/* Reads element i of an integer buffer; unsigned 64-bit values above INT64_MAX fail. */
+static int tron_buffer_i64(const Py_buffer *view, char code, Py_ssize_t i, int64_t *out)
+{
+    const unsigned char *p = (const unsigned char *)view->buf + i * view->itemsize;
+    bool is_signed = strchr("bhilqn", code) != NULL;
+    switch (view->itemsize) {
+    case 1:
+        *out = is_signed ? (int64_t)*(const int8_t *)p : (int64_t)*p;
+        return 0;
+    case 2: {
+        uint16_t v;
+        memcpy(&v, p, sizeof(v));
+        *out = is_signed ? (int64_t)(int16_t)v : (int64_t)v;
+        return 0;
+    }
+    case 4: {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        *out = is_signed ? (int64_t)(int32_t)v : (int64_t)v;
+        return 0;
+    }
+    default: {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        if (!is_signed && v > (uint64_t)INT64_MAX) {
+            PyErr_Format(PyExc_OverflowError, "element %zd does not fit in int64", i);
+            return -1;
+        }
+        *out = (int64_t)v;
+        return 0;
+    }
+    }
+}
+
+/* Shared body of arr_extend_i64/arr_extend_f64: validates the whole source first, grows
+ * once, then appends in one C loop, so a bad element never leaves a partial extend. */
+static PyObject *tron_arr_extend(TronObject *self, tron_argparser *parser, PyObject *const *args, Py_ssize_t nargs,
+                                 PyObject *kwnames, bool is_f64)
+{
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0) {
+        return NULL;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(argv[0], &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return NULL;
+    }
+    char code = tron_buffer_code(&view);
+    bool ok = view.ndim <= 1 && code &&
+              (is_f64 ? (code == 'd' && view.itemsize == 8) || (code == 'f' && view.itemsize == 4)
+                      : strchr("bhilqnBHILQN", code) != NULL &&
+                            (view.itemsize == 1 || view.itemsize == 2 || view.itemsize == 4 || view.itemsize == 8));
+    if (!ok) {
+        PyErr_Format(PyExc_TypeError, "%s() needs a 1-D %s buffer, got format '%s'", parser->fname,
+                     is_f64 ? "float ('d' or 'f')" : "integer", view.format ? view.format : "B");
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    Py_ssize_t count = view.len / view.itemsize;
+    int64_t ival = 0;
+    if (!is_f64 && view.itemsize == 8 && strchr("LQN", code)) {
+        for (Py_ssize_t i = 0; i < count; i++) {
+            if (tron_buffer_i64(&view, code, i, &ival) < 0) {
+                PyBuffer_Release(&view);
+                return NULL;
+            }
+        }
+    }
+
+    size_t per_item = TRON_ENTRY_OVERHEAD + sizeof(int64_t);
+    size_t extra = (size_t)count <= LITE3_BUF_SIZE_MAX / per_item ? (size_t)count * per_item : LITE3_BUF_SIZE_MAX;
+    if (tron_check_mutable(self) < 0 || tron_check_arr(self->ctx, ofs) < 0 || tron_reserve(self, extra) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    int ret = 0;
+    for (Py_ssize_t i = 0; i < count && ret == 0; i++) {
+        if (is_f64) {
+            double dval = 0.0;
+            if (code == 'd') {
+                memcpy(&dval, (const unsigned char *)view.buf + i * 8, sizeof(dval));
+            } else {
+                float fval;
+                memcpy(&fval, (const unsigned char *)view.buf + i * 4, sizeof(fval));
+                dval = fval;
+            }
+            ret = lite3_ctx_arr_append_f64(self->ctx, (size_t)ofs, dval);
+        } else {
+            tron_buffer_i64(&view, code, i, &ival);
+            ret = lite3_ctx_arr_append_i64(self->ctx, (size_t)ofs, ival);
+        }
+    }
+    PyBuffer_Release(&view);
+
+    if (ret < 0) {
+        return tron_raise_errno(is_f64 ? "lite3_ctx_arr_append_f64" : "lite3_ctx_arr_append_i64");
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_arr_extend_i64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_extend_i64", 1, "values", "ofs");
+    return tron_arr_extend(self, &parser, args, nargs, kwnames, false);
+}
+
+static PyObject *Tron_arr_extend_f64(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_extend_f64", 1, "values", "ofs");
+    return tron_arr_extend(self, &parser, args, nargs, kwnames, true);
+}
+
+/* Copies a numeric array into out (typecode 'q' or 'd', or raw bytes) in one iterator
+ * pass. Without out, returns a new array.array; with out, returns the element count. */
+static PyObject *Tron_arr_to_buffer(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "arr_to_buffer", 0, "ofs", "typecode", "out");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+    const char *typecode = "d";
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0 || tron_arg_cstr(argv[1], &typecode) < 0) {
+        return NULL;
+    }
+    bool as_f64 = strcmp(typecode, "d") == 0;
+    if (!as_f64 && strcmp(typecode, "q") != 0) {
+        PyErr_SetString(PyExc_ValueError, "typecode must be 'q' or 'd'");
+        return NULL;
+    }
+
+    uint32_t count = 0;
+    if (tron_check_arr(self->ctx, ofs) < 0) {
+        return NULL;
+    }
+    if (lite3_count(self->ctx->buf, self->ctx->buflen, (size_t)ofs, &count) < 0) {
+        return tron_raise_errno("lite3_count");
+    }
+
+    PyObject *result = NULL;
+    PyObject *target = argv[2] && argv[2] != Py_None ? argv[2] : NULL;
+    if (!target) {
+        PyObject *array_type = tron_import_attr("array", "array");
+        if (!array_type) {
+            return NULL;
+        }
+        PyObject *one = PyObject_CallFunction(array_type, "s(i)", typecode, 0);
+        Py_DECREF(array_type);
+        if (!one) {
+            return NULL;
+        }
+        result = PySequence_Repeat(one, (Py_ssize_t)count);
+        Py_DECREF(one);
+        if (!result) {
+            return NULL;
+        }
+        target = result;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(target, &view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        Py_XDECREF(result);
+        return NULL;
+    }
+    char code = tron_buffer_code(&view);
+    bool raw = code == 'B' || code == 'b' || code == 'c';
+    bool matches = raw || (view.itemsize == 8 && (as_f64 ? code == 'd' : strchr("qln", code) != NULL));
+    if (!matches || (size_t)view.len < (size_t)count * 8) {
+        if (!matches) {
+            PyErr_Format(PyExc_TypeError, "out must be a byte or '%s' buffer, got format '%s'", typecode,
+                         view.format ? view.format : "B");
+        } else {
+            PyErr_Format(PyExc_ValueError, "out holds %zd bytes, %zd needed", view.len, (Py_ssize_t)count * 8);
+        }
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        return NULL;
+    }
+
+    /* Creating the array and out.__buffer__ may run Python code that grows this Tron, so
+     * ctx->buf is only read from here on, and the count must still be the one sized for. */
+    if (!self->ctx) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        tron_raise_released();
+        return NULL;
+    }
+    const unsigned char *buf = self->ctx->buf;
+    size_t buflen = self->ctx->buflen;
+    uint32_t now = 0;
+    if (tron_check_arr(self->ctx, ofs) < 0) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        return NULL;
+    }
+    if (lite3_count(buf, buflen, (size_t)ofs, &now) < 0) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        return tron_raise_errno("lite3_count");
+    }
+    if (now != count) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        PyErr_SetString(PyExc_RuntimeError, "array changed size during arr_to_buffer()");
+        return NULL;
+    }
+
+    lite3_iter iter;
+    if (lite3_iter_create(buf, buflen, (size_t)ofs, &iter) < 0) {
+        PyBuffer_Release(&view);
+        Py_XDECREF(result);
+        return tron_raise_errno("lite3_iter_create");
+    }
+    unsigned char *dst = (unsigned char *)view.buf;
+    size_t val_ofs = 0;
+    Py_ssize_t index = 0;
+    int ret;
+    while (index < (Py_ssize_t)count && (ret = lite3_iter_next(buf, buflen, &iter, NULL, &val_ofs)) == LITE3_ITER_ITEM) {
+        const lite3_val *val = (const lite3_val *)(buf + val_ofs);
+        enum lite3_type type = lite3_val_type(val);
+        if (type == LITE3_TYPE_I64 && !as_f64) {
+            int64_t v = lite3_val_i64(val);
+            memcpy(dst + index * 8, &v, sizeof(v));
+        } else if (type == LITE3_TYPE_I64 || type == LITE3_TYPE_F64) {
+            double v = type == LITE3_TYPE_F64 ? lite3_val_f64(val) : (double)lite3_val_i64(val);
+            if (!as_f64) {
+                PyBuffer_Release(&view);
+                Py_XDECREF(result);
+                PyErr_Format(TronError, "element %zd is a float, not an int64", index);
+                return NULL;
+            }
+            memcpy(dst + index * 8, &v, sizeof(v));
+        } else {
+            PyBuffer_Release(&view);
+            Py_XDECREF(result);
+            PyErr_Format(TronError, "element %zd is not a number", index);
+            return NULL;
+        }
+        index++;
+    }
+    PyBuffer_Release(&view);
+
+    if (index < (Py_ssize_t)count) {
+        Py_XDECREF(result);
+        return tron_raise_errno("lite3_iter_next");
+    }
+    return result ? result : PyLong_FromSsize_t(index);
+}
+
+/* Column types of to_columns(): numeric and bool columns are one array.array each,
+ * str/bytes columns are Arrow-style (offsets array('q') of count + 1, data bytes). */
+enum tron_col_kind {
+    TRON_COL_I64,
+    TRON_COL_F64,
+    TRON_COL_BOOL,
+    TRON_COL_STR,
+    TRON_COL_BYTES,
+};
+
+static const char *const tron_col_kind_names[] = {"i64", "f64", "bool", "str", "bytes"};
+
+static int tron_col_kind_parse(PyObject *name, enum tron_col_kind *out)
+{
+    const char *text = PyUnicode_Check(name) ? PyUnicode_AsUTF8(name) : NULL;
+    for (int i = 0; text && i < (int)(sizeof(tron_col_kind_names) / sizeof(tron_col_kind_names[0])); i++) {
+        if (strcmp(text, tron_col_kind_names[i]) == 0) {
+            *out = (enum tron_col_kind)i;
+            return 0;
+        }
+    }
+    if (!PyErr_Occurred()) {
+        PyErr_Format(PyExc_ValueError, "column type must be one of i64, f64, bool, str, bytes; got %R", name);
+    }
+    return -1;
+}
+
+typedef struct {
+    PyObject *name;
+    tron_key key;
+    enum tron_col_kind kind;
+    PyObject *values; /* array of count (count + 1 offsets for str/bytes) */
+    Py_buffer view;
+    char *data; /* str/bytes payload, PyMem_Raw */
+    size_t data_len;
+    size_t data_cap;
+} tron_column;
+
+enum tron_col_error {
+    TRON_COL_OK,
+    TRON_COL_NOT_OBJECT,
+    TRON_COL_MISSING,
+    TRON_COL_WRONG_TYPE,
+    TRON_COL_NO_MEMORY,
+    TRON_COL_ITER,
+};
+
+/* Fills every column in one pass over the array; runs without the GIL, so failures come
+ * back as a code plus the record/column they happened at. */
+static enum tron_col_error tron_columns_scan(const unsigned char *buf, size_t buflen, size_t ofs, tron_column *cols,
+                                             Py_ssize_t ncols, uint32_t count, uint32_t *bad_row, Py_ssize_t *bad_col)
+{
+    lite3_iter iter;
+    if (lite3_iter_create(buf, buflen, ofs, &iter) < 0) {
+        return TRON_COL_ITER;
+    }
+
+    size_t rec_ofs = 0;
+    for (uint32_t row = 0; row < count; row++) {
+        *bad_row = row;
+        *bad_col = -1;
+        if (lite3_iter_next(buf, buflen, &iter, NULL, &rec_ofs) != LITE3_ITER_ITEM) {
+            return TRON_COL_ITER;
+        }
+        if (lite3_val_type((const lite3_val *)(buf + rec_ofs)) != LITE3_TYPE_OBJECT) {
+            return TRON_COL_NOT_OBJECT;
+        }
+
+        for (Py_ssize_t c = 0; c < ncols; c++) {
+            tron_column *col = &cols[c];
+            lite3_val *val = NULL;
+            *bad_col = c;
+            if (lite3_get_impl(buf, buflen, rec_ofs, col->key.key, col->key.key_data, &val) < 0 ||
+                lite3_val_type(val) == LITE3_TYPE_NULL) {
+                return TRON_COL_MISSING;
+            }
+
+            enum lite3_type type = lite3_val_type(val);
+            unsigned char *dst = (unsigned char *)col->view.buf;
+            if (col->kind == TRON_COL_I64 && type == LITE3_TYPE_I64) {
+                int64_t v = lite3_val_i64(val);
+                memcpy(dst + (size_t)row * 8, &v, sizeof(v));
+            } else if (col->kind == TRON_COL_F64 && (type == LITE3_TYPE_F64 || type == LITE3_TYPE_I64)) {
+                double v = type == LITE3_TYPE_F64 ? lite3_val_f64(val) : (double)lite3_val_i64(val);
+                memcpy(dst + (size_t)row * 8, &v, sizeof(v));
+            } else if (col->kind == TRON_COL_BOOL && type == LITE3_TYPE_BOOL) {
+                dst[row] = lite3_val_bool(val) ? 1 : 0;
+            } else if ((col->kind == TRON_COL_STR && type == LITE3_TYPE_STRING) ||
+                       (col->kind == TRON_COL_BYTES && type == LITE3_TYPE_BYTES)) {
+                size_t len = 0;
+                const void *src = type == LITE3_TYPE_STRING ? (const void *)lite3_val_str_n(val, &len)
+                                                            : (const void *)lite3_val_bytes(val, &len);
+                if (col->data_len + len > col->data_cap) {
+                    size_t cap = col->data_cap ? col->data_cap * 2 : 4096;
+                    while (cap < col->data_len + len) {
+                        cap *= 2;
+                    }
+                    char *grown = (char *)PyMem_RawRealloc(col->data, cap);
+                    if (!grown) {
+                        return TRON_COL_NO_MEMORY;
+                    }
+                    col->data = grown;
+                    col->data_cap = cap;
+                }
+                memcpy(col->data + col->data_len, src, len);
+                col->data_len += len;
+                int64_t end = (int64_t)col->data_len;
+                memcpy(dst + ((size_t)row + 1) * 8, &end, sizeof(end));
+            } else {
+                return TRON_COL_WRONG_TYPE;
+            }
+        }
+    }
+    return TRON_COL_OK;
+}
+
+static void tron_columns_free(tron_column *cols, Py_ssize_t ncols)
+{
+    for (Py_ssize_t c = 0; c < ncols; c++) {
+        if (cols[c].view.obj) {
+            PyBuffer_Release(&cols[c].view);
+        }
+        Py_XDECREF(cols[c].values);
+        PyMem_RawFree(cols[c].data);
+    }
+    PyMem_Free(cols);
+}
+
+/* Transposes an array of objects into per-field contiguous buffers in one scan with
+ * the GIL released; each key is hashed once, not once per record. */
+static PyObject *Tron_to_columns(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_columns", 3, "ofs", "fields", "types");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0 || tron_check_arr(self->ctx, ofs) < 0) {
+        return NULL;
+    }
+
+    PyObject *fields = tron_arg_items(argv[1], "fields must be a sequence");
+    if (!fields) {
+        return NULL;
+    }
+    PyObject *types = tron_arg_items(argv[2], "types must be a sequence");
+    if (!types) {
+        Py_DECREF(fields);
+        return NULL;
+    }
+
+    PyObject *result = NULL;
+    PyObject *array_type = NULL;
+    Py_ssize_t ncols = PySequence_Fast_GET_SIZE(fields);
+    tron_column *cols = (tron_column *)PyMem_Calloc(ncols ? (size_t)ncols : 1, sizeof(tron_column));
+    if (!cols) {
+        PyErr_NoMemory();
+        goto done;
+    }
+    if (PySequence_Fast_GET_SIZE(types) != ncols) {
+        PyErr_SetString(PyExc_ValueError, "fields and types must have the same length");
+        goto done;
+    }
+
+    uint32_t count = 0;
+    if (lite3_count(self->ctx->buf, self->ctx->buflen, (size_t)ofs, &count) < 0) {
+        tron_raise_errno("lite3_count");
+        goto done;
+    }
+    array_type = tron_import_attr("array", "array");
+    if (!array_type) {
+        goto done;
+    }
+
+    for (Py_ssize_t c = 0; c < ncols; c++) {
+        tron_column *col = &cols[c];
+        PyObject *field = PySequence_Fast_GET_ITEM(fields, c);
+        if (tron_arg_key(field, &col->key) < 0 ||
+            tron_col_kind_parse(PySequence_Fast_GET_ITEM(types, c), &col->kind) < 0) {
+            goto done;
+        }
+        col->name = Py_IS_TYPE(field, &KeyType) ? ((KeyObject *)field)->name : field;
+
+        bool is_var = col->kind == TRON_COL_STR || col->kind == TRON_COL_BYTES;
+        const char *typecode = col->kind == TRON_COL_F64 ? "d" : col->kind == TRON_COL_BOOL ? "b" : "q";
+        PyObject *one = PyObject_CallFunction(array_type, "s(i)", typecode, 0);
+        if (!one) {
+            goto done;
+        }
+        col->values = PySequence_Repeat(one, (Py_ssize_t)count + (is_var ? 1 : 0));
+        Py_DECREF(one);
+        if (!col->values || PyObject_GetBuffer(col->values, &col->view, PyBUF_WRITABLE) < 0) {
+            goto done;
+        }
+    }
+
+    /* Importing array and building the columns ran Python code that may have written,
+     * re-initialized or released this Tron, so the array is checked again under the lock
+     * and must still hold the count the columns were sized for. */
+    uint32_t now = 0;
+    tron_read_begin(self);
+    if (!self->ctx) {
+        tron_read_end(self);
+        tron_raise_released();
+        goto done;
+    }
+    if (tron_check_arr(self->ctx, ofs) < 0) {
+        tron_read_end(self);
+        goto done;
+    }
+    if (lite3_count(self->ctx->buf, self->ctx->buflen, (size_t)ofs, &now) < 0) {
+        tron_read_end(self);
+        tron_raise_errno("lite3_count");
+        goto done;
+    }
+    if (now != count) {
+        tron_read_end(self);
+        PyErr_SetString(PyExc_RuntimeError, "array changed size during to_columns()");
+        goto done;
+    }
+
+    uint32_t bad_row = 0;
+    Py_ssize_t bad_col = -1;
+    enum tron_col_error err;
+    Py_BEGIN_ALLOW_THREADS
+    err = tron_columns_scan(self->ctx->buf, self->ctx->buflen, (size_t)ofs, cols, ncols, count, &bad_row, &bad_col);
+    Py_END_ALLOW_THREADS
+    tron_read_end(self);
+
+    switch (err) {
+    case TRON_COL_OK:
+        break;
+    case TRON_COL_NOT_OBJECT:
+        PyErr_Format(TronError, "record %u is not an object", bad_row);
+        goto done;
+    case TRON_COL_MISSING:
+        PyErr_Format(TronError, "record %u: field %R is missing or null", bad_row, cols[bad_col].name);
+        goto done;
+    case TRON_COL_WRONG_TYPE:
+        PyErr_Format(TronError, "record %u: field %R is not %s", bad_row, cols[bad_col].name,
+                     tron_col_kind_names[cols[bad_col].kind]);
+        goto done;
+    case TRON_COL_NO_MEMORY:
+        PyErr_NoMemory();
+        goto done;
+    case TRON_COL_ITER:
+        tron_raise_errno("lite3_iter_next");
+        goto done;
+    }
+
+    result = PyDict_New();
+    for (Py_ssize_t c = 0; result && c < ncols; c++) {
+        tron_column *col = &cols[c];
+        PyObject *column = NULL;
+        if (col->kind == TRON_COL_STR || col->kind == TRON_COL_BYTES) {
+            PyObject *data = PyBytes_FromStringAndSize(col->data ? col->data : "", (Py_ssize_t)col->data_len);
+            column = data ? PyTuple_Pack(2, col->values, data) : NULL;
+            Py_XDECREF(data);
+        } else {
+            column = Py_NewRef(col->values);
+        }
+        if (!column || PyDict_SetItem(result, col->name, column) < 0) {
+            Py_CLEAR(result);
+        }
+        Py_XDECREF(column);
+    }
+
+done:
+    if (cols) {
+        tron_columns_free(cols, ncols);
+    }
+    Py_XDECREF(array_type);
+    Py_DECREF(fields);
+    Py_DECREF(types);
+    return result;
+}
+
+/* One input column of extend_columns(): a typed buffer, an Arrow-style (offsets, data)
+ * str/bytes pair, or a list/tuple of Python values converted cell by cell. typed is set
+ * when types= named the column's kind instead of leaving it to be inferred. */
+typedef struct {
+    PyObject *name;
+    tron_key key;
+    enum tron_col_kind kind;
+    bool typed;
+    bool is_py;
+    PyObject *seq;
+    Py_buffer view; /* values, or the offsets of a (offsets, data) pair */
+    Py_buffer data;
+    char code;
+} tron_col_source;
+
+static bool tron_is_offsets(PyObject *obj)
+{
+    if (!PyObject_CheckBuffer(obj) || PyBytes_Check(obj) || PyByteArray_Check(obj)) {
+        return false;
+    }
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        PyErr_Clear();
+        return false;
+    }
+    char code = tron_buffer_code(&view);
+    bool ok = view.ndim == 1 && code && strchr("ilqn", code) && view.itemsize >= 4;
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+/* Length of the longest valid UTF-8 prefix of s[0, n), by the same rules as Python's strict
+ * decoder: no overlong forms, surrogates or code points past U+10FFFF. */
+static size_t tron_utf8_prefix(const unsigned char *s, size_t n)
+{
+    size_t i = 0;
+    while (i < n) {
+        unsigned char c = s[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+        size_t len = c >= 0xC2 && c <= 0xDF ? 2 : c >= 0xE0 && c <= 0xEF ? 3 : c >= 0xF0 && c <= 0xF4 ? 4 : 0;
+        if (len == 0 || len > n - i) {
+            return i;
+        }
+        unsigned char lo = c == 0xE0 ? 0xA0 : c == 0xF0 ? 0x90 : 0x80;
+        unsigned char hi = c == 0xED ? 0x9F : c == 0xF4 ? 0x8F : 0xBF;
+        if (s[i + 1] < lo || s[i + 1] > hi) {
+            return i;
+        }
+        for (size_t k = 2; k < len; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+        }
+        i += len;
+    }
+    return n;
+}
+
+/* Opens col_obj as a column and returns its row count, or -1. col->kind is inferred
+ * unless col->typed: a pair is str, '?' is bool, 'd'/'f' are f64, integers are i64. */
+static Py_ssize_t tron_col_source_open(tron_col_source *col, PyObject *col_obj)
+{
+    bool is_var = !col->typed || col->kind == TRON_COL_STR || col->kind == TRON_COL_BYTES;
+    if (is_var && PyTuple_Check(col_obj) && PyTuple_GET_SIZE(col_obj) == 2 &&
+        tron_is_offsets(PyTuple_GET_ITEM(col_obj, 0)) && PyObject_CheckBuffer(PyTuple_GET_ITEM(col_obj, 1))) {
+        if (!col->typed) {
+            col->kind = TRON_COL_STR;
+        }
+        if (PyObject_GetBuffer(PyTuple_GET_ITEM(col_obj, 0), &col->view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0 ||
+            PyObject_GetBuffer(PyTuple_GET_ITEM(col_obj, 1), &col->data, PyBUF_SIMPLE) < 0) {
+            return -1;
+        }
+        col->code = tron_buffer_code(&col->view);
+        Py_ssize_t count = col->view.len / col->view.itemsize - 1;
+        const unsigned char *data = (const unsigned char *)col->data.buf;
+        int64_t prev = 0;
+        for (Py_ssize_t i = 0; i <= count; i++) {
+            int64_t pos = 0;
+            tron_buffer_i64(&col->view, col->code, i, &pos);
+            if (pos < prev || pos > (int64_t)col->data.len) {
+                PyErr_Format(PyExc_ValueError, "%s column offsets[%zd] = %lld is out of order or past the data",
+                             tron_col_kind_names[col->kind], i, (long long)pos);
+                return -1;
+            }
+            /* Each cell must be UTF-8 on its own; only a bad one is decoded, for the error. */
+            size_t len = (size_t)(pos - prev);
+            if (i > 0 && col->kind == TRON_COL_STR && tron_utf8_prefix(data + prev, len) != len) {
+                PyObject *text = PyUnicode_DecodeUTF8((const char *)data + prev, (Py_ssize_t)len, "strict");
+                if (text) {
+                    Py_DECREF(text);
+                    PyErr_Format(PyExc_ValueError, "str column row %zd is not valid UTF-8", i - 1);
+                }
+                return -1;
+            }
+            prev = pos;
+        }
+        return count < 0 ? 0 : count;
+    }
+
+    if (PyList_Check(col_obj) || PyTuple_Check(col_obj)) {
+        /* A tuple snapshot, so the cells checked up front are the ones written. */
+        col->is_py = true;
+        col->seq = PySequence_Tuple(col_obj);
+        return col->seq ? PyTuple_GET_SIZE(col->seq) : -1;
+    }
+
+    if (PyObject_GetBuffer(col_obj, &col->view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        return -1;
+    }
+    col->code = tron_buffer_code(&col->view);
+    char code = col->code;
+    Py_ssize_t itemsize = col->view.itemsize;
+    bool is_bool = code == '?' && itemsize == 1;
+    bool is_float = (code == 'd' && itemsize == 8) || (code == 'f' && itemsize == 4);
+    bool is_int = code && strchr("bhilqnBHILQN", code) &&
+                  (itemsize == 1 || itemsize == 2 || itemsize == 4 || itemsize == 8);
+    if (col->view.ndim > 1) {
+        is_bool = is_float = is_int = false;
+    }
+    if (!col->typed) {
+        col->kind = is_bool ? TRON_COL_BOOL : is_float ? TRON_COL_F64 : TRON_COL_I64;
+    }
+
+    bool ok;
+    switch (col->kind) {
+    case TRON_COL_I64:
+        ok = is_int;
+        break;
+    case TRON_COL_F64:
+        ok = is_float || (col->typed && is_int);
+        break;
+    case TRON_COL_BOOL:
+        /* to_columns() hands bool columns out as array('b') of 0/1. */
+        ok = is_bool || (col->typed && is_int && itemsize == 1);
+        break;
+    default:
+        PyErr_Format(PyExc_TypeError, "a %s column must be an (offsets, data) pair or a list",
+                     tron_col_kind_names[col->kind]);
+        return -1;
+    }
+    if (!ok) {
+        PyErr_Format(PyExc_TypeError, "column buffer has unsupported format '%s' for %s",
+                     col->view.format ? col->view.format : "B", tron_col_kind_names[col->kind]);
+        return -1;
+    }
+
+    Py_ssize_t count = col->view.len / itemsize;
+    int64_t value = 0;
+    if (is_int && itemsize == 8 && strchr("LQN", code)) {
+        for (Py_ssize_t i = 0; i < count; i++) {
+            if (tron_buffer_i64(&col->view, code, i, &value) < 0) {
+                return -1;
+            }
+        }
+    }
+    return count;
+}
+
+static void tron_col_sources_free(tron_col_source *cols, Py_ssize_t ncols)
+{
+    for (Py_ssize_t c = 0; c < ncols; c++) {
+        if (cols[c].view.obj) {
+            PyBuffer_Release(&cols[c].view);
+        }
+        if (cols[c].data.obj) {
+            PyBuffer_Release(&cols[c].data);
+        }
+        Py_XDECREF(cols[c].seq);
+    }
+    PyMem_Free(cols);
+}
+
+/* A list cell of a column whose kind types= fixed must be exactly that kind, and must
+ * convert without error. */
+static int tron_col_check_cell(const tron_col_source *col, PyObject *cell, Py_ssize_t row)
+{
+    bool ok;
+    switch (col->kind) {
+    case TRON_COL_I64:
+        ok = PyLong_Check(cell) && !PyBool_Check(cell);
+        break;
+    case TRON_COL_F64:
+        ok = PyFloat_Check(cell) || (PyLong_Check(cell) && !PyBool_Check(cell));
+        break;
+    case TRON_COL_BOOL:
+        ok = PyBool_Check(cell);
+        break;
+    case TRON_COL_STR:
+        ok = PyUnicode_Check(cell);
+        break;
+    default:
+        ok = PyBytes_Check(cell) || PyByteArray_Check(cell) || PyMemoryView_Check(cell);
+        break;
+    }
+    if (!ok) {
+        PyErr_Format(PyExc_TypeError, "column %R row %zd: expected %s, got %T", col->name, row,
+                     tron_col_kind_names[col->kind], cell);
+        return -1;
+    }
+    if (col->kind == TRON_COL_F64) {
+        double number = PyFloat_AsDouble(cell);
+        return number == -1.0 && PyErr_Occurred() ? -1 : 0;
+    }
+    return tron_check_value(cell);
+}
+
+static int tron_col_put_cell(lite3_ctx *ctx, size_t rec, const tron_col_source *col, PyObject *cell)
+{
+    switch (col->kind) {
+    case TRON_COL_I64:
+        return tron_put_i64(ctx, rec, &col->key, cell);
+    case TRON_COL_F64:
+        return tron_put_f64(ctx, rec, &col->key, cell);
+    case TRON_COL_BOOL:
+        return tron_put_bool(ctx, rec, &col->key, cell == Py_True);
+    case TRON_COL_STR:
+        return tron_put_str(ctx, rec, &col->key, cell);
+    default:
+        return tron_put_bytes(ctx, rec, &col->key, cell);
+    }
+}
+
+/* Reads the kind types= gives the column called name, if any; returns 1 when found. */
+static int tron_col_type_lookup(PyObject *types, PyObject *name, enum tron_col_kind *out)
+{
+    PyObject *kind_obj = NULL;
+    int found = PyMapping_GetOptionalItem(types, name, &kind_obj);
+    if (found <= 0) {
+        return found;
+    }
+    int ret = tron_col_kind_parse(kind_obj, out);
+    Py_DECREF(kind_obj);
+    return ret < 0 ? -1 : 1;
+}
+
+/* Appends one object per row to the array at ofs. Every column and cell is checked and the
+ * buffer grown once before the first record, so bad input leaves the array as it was; each
+ * key is hashed once per column. types maps column names to to_columns() kinds, so bool
+ * and bytes columns round-trip. */
+static int tron_extend_columns(TronObject *self, PyObject *columns, PyObject *types, Py_ssize_t ofs)
+{
+    PyObject *items = PyMapping_Items(columns);
+    if (!items) {
+        return -1;
+    }
+
+    int ret = -1;
+    Py_ssize_t ncols = PyList_GET_SIZE(items);
+    Py_ssize_t rows = -1;
+    Py_ssize_t ntyped = 0;
+    tron_col_source *cols = (tron_col_source *)PyMem_Calloc(ncols ? (size_t)ncols : 1, sizeof(tron_col_source));
+    if (!cols) {
+        PyErr_NoMemory();
+        goto done;
+    }
+
+    size_t per_row = LITE3_NODE_SIZE + TRON_ENTRY_OVERHEAD;
+    size_t extra = 0;
+    for (Py_ssize_t c = 0; c < ncols; c++) {
+        PyObject *item = PyList_GET_ITEM(items, c);
+        if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
+            PyErr_SetString(PyExc_TypeError, "columns must be a mapping");
+            goto done;
+        }
+        PyObject *key_obj = PyTuple_GET_ITEM(item, 0);
+        if (tron_arg_key(key_obj, &cols[c].key) < 0) {
+            goto done;
+        }
+        cols[c].name = Py_IS_TYPE(key_obj, &KeyType) ? ((KeyObject *)key_obj)->name : key_obj;
+        if (types) {
+            int found = tron_col_type_lookup(types, cols[c].name, &cols[c].kind);
+            if (found < 0) {
+                goto done;
+            }
+            cols[c].typed = found == 1;
+            ntyped += found;
+        }
+        Py_ssize_t count = tron_col_source_open(&cols[c], PyTuple_GET_ITEM(item, 1));
+        if (count < 0) {
+            goto done;
+        }
+        if (rows >= 0 && count != rows) {
+            PyErr_Format(PyExc_ValueError, "column %R has %zd rows, expected %zd", key_obj, count, rows);
+            goto done;
+        }
+        rows = count;
+
+        per_row += TRON_ENTRY_OVERHEAD + cols[c].key.key_data.size + sizeof(int64_t);
+        if (cols[c].data.obj) {
+            extra += (size_t)cols[c].data.len;
+        }
+        for (Py_ssize_t i = 0; cols[c].is_py && i < count; i++) {
+            PyObject *cell = PyTuple_GET_ITEM(cols[c].seq, i);
+            if (cols[c].typed ? tron_col_check_cell(&cols[c], cell, i) < 0 : tron_check_value(cell) < 0) {
+                goto done;
+            }
+            extra += tron_estimate_value(cell, 0);
+        }
+    }
+    if (types) {
+        Py_ssize_t ntypes = PyObject_Length(types);
+        if (ntypes < 0) {
+            goto done;
+        }
+        if (ntypes != ntyped) {
+            PyErr_SetString(PyExc_ValueError, "types names a column that is not in columns");
+            goto done;
+        }
+    }
+    if (tron_check_mutable(self) < 0 || tron_check_arr(self->ctx, ofs) < 0) {
+        goto done;
+    }
+    if (rows <= 0) {
+        ret = 0;
+        goto done;
+    }
+    extra += (size_t)rows <= LITE3_BUF_SIZE_MAX / per_row ? (size_t)rows * per_row : LITE3_BUF_SIZE_MAX;
+    if (tron_reserve(self, extra) < 0) {
+        goto done;
+    }
+
+    lite3_ctx *ctx = self->ctx;
+    for (Py_ssize_t row = 0; row < rows; row++) {
+        size_t rec = 0;
+        if (lite3_ctx_arr_append_obj(ctx, (size_t)ofs, &rec) < 0) {
+            tron_raise_errno("lite3_ctx_arr_append_obj");
+            goto done;
+        }
+        for (Py_ssize_t c = 0; c < ncols; c++) {
+            tron_col_source *col = &cols[c];
+            const unsigned char *src = (const unsigned char *)col->view.buf;
+            int set_ret = 0;
+            const char *failed = NULL;
+            if (col->is_py) {
+                PyObject *cell = PyTuple_GET_ITEM(col->seq, row);
+                if (!col->typed ? tron_put_value(ctx, rec, &col->key, cell) < 0
+                                : tron_col_put_cell(ctx, rec, col, cell) < 0) {
+                    goto done;
+                }
+                continue;
+            }
+            switch (col->kind) {
+            case TRON_COL_I64: {
+                int64_t v = 0;
+                tron_buffer_i64(&col->view, col->code, row, &v);
+                set_ret = tron_ctx_set_i64(ctx, rec, &col->key, v);
+                failed = "lite3_set_i64";
+                break;
+            }
+            case TRON_COL_F64: {
+                double v = 0.0;
+                if (col->code == 'd') {
+                    memcpy(&v, src + row * 8, sizeof(v));
+                } else if (col->code == 'f') {
+                    float f;
+                    memcpy(&f, src + row * 4, sizeof(f));
+                    v = f;
+                } else {
+                    int64_t i = 0;
+                    tron_buffer_i64(&col->view, col->code, row, &i);
+                    v = (double)i;
+                }
+                set_ret = tron_ctx_set_f64(ctx, rec, &col->key, v);
+                failed = "lite3_set_f64";
+                break;
+            }
+            case TRON_COL_BOOL:
+                set_ret = tron_ctx_set_bool(ctx, rec, &col->key, src[row] != 0);
+                failed = "lite3_set_bool";
+                break;
+            default: {
+                int64_t start = 0;
+                int64_t end = 0;
+                tron_buffer_i64(&col->view, col->code, row, &start);
+                tron_buffer_i64(&col->view, col->code, row + 1, &end);
+                const unsigned char *bytes = (const unsigned char *)col->data.buf + start;
+                if (col->kind == TRON_COL_STR) {
+                    set_ret = tron_ctx_set_str(ctx, rec, &col->key, (const char *)bytes, (size_t)(end - start));
+                    failed = "lite3_set_str";
+                } else {
+                    set_ret = tron_ctx_set_bytes(ctx, rec, &col->key, bytes, (size_t)(end - start));
+                    failed = "lite3_set_bytes";
+                }
+                break;
+            }
+            }
+            if (set_ret < 0) {
+                tron_raise_errno(failed);
+                goto done;
+            }
+        }
+    }
+    ret = 0;
+
+done:
+    if (cols) {
+        tron_col_sources_free(cols, ncols);
+    }
+    Py_DECREF(items);
+    return ret;
+}
+
+static PyObject *Tron_extend_columns(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "extend_columns", 1, "columns", "ofs", "types");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    PyObject *types = argv[2] != Py_None ? argv[2] : NULL;
+    if (tron_arg_ssize(argv[1], &ofs) < 0 || tron_extend_columns(self, argv[0], types, ofs) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_from_columns(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "from_columns", 1, "columns", "types");
+    PyObject *argv[2];
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    PyObject *types = argv[1] != Py_None ? argv[1] : NULL;
+
+    lite3_ctx *ctx = lite3_ctx_create();
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create");
+    }
+    if (lite3_ctx_init_arr(ctx) < 0) {
+        tron_raise_errno("lite3_ctx_init_arr");
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+    /* Not behind TRON_LOCKED, so drop the write lock tron_check_mutable() took here. */
+    int ret = tron_extend_columns(self, argv[0], types, 0);
+    tron_unlock_to(self, 0);
+    if (ret < 0) {
+        Py_DECREF(self);
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+static int tron_pred_cmp(enum tron_pred_op op, int cmp)
+{
+    switch (op) {
+    case TRON_PRED_EQ:
+        return cmp == 0;
+    case TRON_PRED_NE:
+        return cmp != 0;
+    case TRON_PRED_LT:
+        return cmp < 0;
+    case TRON_PRED_LE:
+        return cmp <= 0;
+    case TRON_PRED_GT:
+        return cmp > 0;
+    default:
+        return cmp >= 0;
+    }
+}
+
+/* Evaluates node against the record at rec without touching Python objects, so it can
+ * run with the GIL released. A missing field or a value of another type never matches. */
+static bool tron_pred_eval(lite3_ctx *ctx, size_t rec, const tron_pred_node *node)
+{
+    const tron_pred_node *child = node + 1;
+    const tron_pred_node *end = node + node->size;
+    switch ((enum tron_pred_op)node->op) {
+    case TRON_PRED_AND:
+        for (; child < end; child += child->size) {
+            if (!tron_pred_eval(ctx, rec, child)) {
+                return false;
+            }
+        }
+        return true;
+    case TRON_PRED_OR:
+        for (; child < end; child += child->size) {
+            if (tron_pred_eval(ctx, rec, child)) {
+                return true;
+            }
+        }
+        return false;
+    case TRON_PRED_NOT:
+        return !tron_pred_eval(ctx, rec, child);
+    default:
+        break;
+    }
+
+    lite3_val *val = NULL;
+    Py_ssize_t failed_at = 0;
+    if (tron_path_walk(ctx, rec, node->field->segs, Py_SIZE(node->field), &val, &failed_at) < 0) {
+        return false;
+    }
+
+    enum tron_pred_op op = (enum tron_pred_op)node->op;
+    enum lite3_type type = lite3_val_type(val);
+    int cmp = 0;
+    switch ((enum tron_pred_kind)node->kind) {
+    case TRON_PRED_NULL:
+        return (type == LITE3_TYPE_NULL) == (op == TRON_PRED_EQ);
+    case TRON_PRED_BOOL:
+        if (type != LITE3_TYPE_BOOL) {
+            return false;
+        }
+        cmp = (int)lite3_val_bool(val) - (int)node->value.b;
+        break;
+    case TRON_PRED_I64:
+    case TRON_PRED_F64:
+        if (type == LITE3_TYPE_I64 && node->kind == TRON_PRED_I64) {
+            int64_t v = lite3_val_i64(val);
+            cmp = (v > node->value.i64) - (v < node->value.i64);
+        } else if (type == LITE3_TYPE_I64 || type == LITE3_TYPE_F64) {
+            double v = type == LITE3_TYPE_F64 ? lite3_val_f64(val) : (double)lite3_val_i64(val);
+            double x = node->kind == TRON_PRED_F64 ? node->value.f64 : (double)node->value.i64;
+            if (isnan(v) || isnan(x)) {
+                return op == TRON_PRED_NE;
+            }
+            cmp = (v > x) - (v < x);
+        } else {
+            return false;
+        }
+        break;
+    case TRON_PRED_STR: {
+        if (type != LITE3_TYPE_STRING) {
+            return false;
+        }
+        size_t len = 0;
+        const char *str = lite3_val_str_n(val, &len);
+        size_t want = node->value.str.len;
+        cmp = memcmp(str, node->value.str.ptr, len < want ? len : want);
+        if (cmp == 0) {
+            cmp = (len > want) - (len < want);
+        }
+        break;
+    }
+    }
+    return tron_pred_cmp(op, cmp);
+}
+
+typedef struct {
+    uint32_t index;
+    size_t ofs;
+} tron_match;
+
+/* Matches of one select() scan, collected with the GIL released (PyMem_Raw). */
+static int tron_select_scan(lite3_ctx *ctx, size_t ofs, const tron_pred_node *where, tron_match **out,
+                            size_t *out_count)
+{
+    lite3_iter iter;
+    if (lite3_iter_create(ctx->buf, ctx->buflen, ofs, &iter) < 0) {
+        return -1;
+    }
+
+    tron_match *matches = NULL;
+    size_t count = 0;
+    size_t cap = 0;
+    size_t rec = 0;
+    uint32_t index = 0;
+    int ret;
+    while ((ret = lite3_iter_next(ctx->buf, ctx->buflen, &iter, NULL, &rec)) == LITE3_ITER_ITEM) {
+        if (!where || tron_pred_eval(ctx, rec, where)) {
+            if (count == cap) {
+                cap = cap ? cap * 2 : 256;
+                tron_match *grown = (tron_match *)PyMem_RawRealloc(matches, cap * sizeof(tron_match));
+                if (!grown) {
+                    PyMem_RawFree(matches);
+                    errno = ENOMEM;
+                    return -1;
+                }
+                matches = grown;
+            }
+            matches[count].index = index;
+            matches[count].ofs = rec;
+            count++;
+        }
+        index++;
+    }
+    if (ret < 0) {
+        PyMem_RawFree(matches);
+        return -1;
+    }
+    *out = matches;
+    *out_count = count;
+    return 0;
+}
+
+/* Filters the array at ofs in C. Returns matching indices, record offsets (offsets=True)
+ * or, with project, one tuple of values per match (None for a missing path). */
+static PyObject *Tron_select(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "select", 0, "ofs", "where", "project", "offsets");
+    PyObject *argv[4];
+    Py_ssize_t ofs = 0;
+    int offsets = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0 || tron_arg_bool(argv[3], &offsets) < 0 ||
+        tron_check_arr(self->ctx, ofs) < 0) {
+        return NULL;
+    }
+    bool has_project = argv[2] && argv[2] != Py_None;
+    if (offsets && has_project) {
+        PyErr_SetString(PyExc_ValueError, "select() takes offsets=True or project, not both");
+        return NULL;
+    }
+
+    PyObject *where = NULL;
+    if (argv[1] && argv[1] != Py_None) {
+        where = Py_IS_TYPE(argv[1], &PredicateType) ? Py_NewRef(argv[1])
+                                                     : PyObject_CallOneArg((PyObject *)&PredicateType, argv[1]);
+        if (!where) {
+            return NULL;
+        }
+        if (!((PredicateObject *)where)->refs) {
+            PyErr_SetString(PyExc_ValueError, "Predicate was cleared by the garbage collector");
+            Py_DECREF(where);
+            return NULL;
+        }
+    }
+
+    PyObject *result = NULL;
+    PyObject *paths = NULL;
+    tron_match *matches = NULL;
+    size_t count = 0;
+    Py_ssize_t nproj = 0;
+    if (has_project) {
+        PyObject *project = tron_arg_items(argv[2], "project must be a sequence of paths");
+        if (!project) {
+            goto done;
+        }
+        nproj = PySequence_Fast_GET_SIZE(project);
+        paths = PyTuple_New(nproj);
+        for (Py_ssize_t i = 0; paths && i < nproj; i++) {
+            PathObject *path = tron_path_from_arg(PySequence_Fast_GET_ITEM(project, i));
+            if (!path) {
+                Py_CLEAR(paths);
+                break;
+            }
+            PyTuple_SET_ITEM(paths, i, (PyObject *)path);
+        }
+        Py_DECREF(project);
+        if (!paths) {
+            goto done;
+        }
+    }
+
+    /* The reader lock stays held while the matches are projected, so their offsets stay
+     * valid; only a write re-entering from this thread can bump the version. */
+    int ret;
+    tron_read_begin(self);
+    uint64_t version = self->version;
+    Py_BEGIN_ALLOW_THREADS
+    ret = tron_select_scan(self->ctx, (size_t)ofs, where ? ((PredicateObject *)where)->nodes : NULL, &matches, &count);
+    Py_END_ALLOW_THREADS
+    if (ret < 0) {
+        tron_raise_errno("lite3_iter_next");
+        goto unlock;
+    }
+
+    result = PyList_New((Py_ssize_t)count);
+    for (size_t m = 0; result && m < count; m++) {
+        if (self->version != version) {
+            PyErr_SetString(PyExc_RuntimeError, "Tron changed during select()");
+            Py_CLEAR(result);
+            break;
+        }
+        PyObject *item = NULL;
+        if (!paths) {
+            item = offsets ? PyLong_FromSize_t(matches[m].ofs) : PyLong_FromUnsignedLong(matches[m].index);
+        } else if ((item = PyTuple_New(nproj))) {
+            for (Py_ssize_t i = 0; i < nproj; i++) {
+                const PathObject *path = (const PathObject *)PyTuple_GET_ITEM(paths, i);
+                lite3_val *val = NULL;
+                Py_ssize_t failed_at = 0;
+                PyObject *value = tron_path_walk(self->ctx, matches[m].ofs, path->segs, Py_SIZE(path), &val, &failed_at) < 0
+                                      ? Py_NewRef(Py_None)
+                                      : tron_val_to_py(self->ctx, val);
+                if (!value) {
+                    Py_CLEAR(item);
+                    break;
+                }
+                PyTuple_SET_ITEM(item, i, value);
+            }
+        }
+        if (!item) {
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, (Py_ssize_t)m, item);
+    }
+
+unlock:
+    tron_read_end(self);
+done:
+    PyMem_RawFree(matches);
+    Py_XDECREF(paths);
+    Py_XDECREF(where);
+    return result;
+}
+
+static PyObject *Tron_to_bytes(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    return PyBytes_FromStringAndSize((const char *)self->ctx->buf, (Py_ssize_t)self->ctx->buflen);
+}
+
+static PyObject *Tron_buflen(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    return PyLong_FromSize_t(self->ctx->buflen);
+}
+
+static PyObject *Tron_bufsz(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    return PyLong_FromSize_t(self->ctx->bufsz);
+}
+
+/* The JSON encoders run under the reader lock with the GIL released. */
+static char *tron_json_enc(TronObject *self, size_t ofs, bool pretty, size_t *out_len)
+{
+    char *json = NULL;
+    int saved_errno = 0;
+    tron_read_begin(self);
+    Py_BEGIN_ALLOW_THREADS
+    if (pretty) {
+        json = lite3_ctx_json_enc_pretty(self->ctx, ofs, out_len);
+    } else {
+        json = lite3_ctx_json_enc(self->ctx, ofs, out_len);
+    }
+    saved_errno = errno;
+    Py_END_ALLOW_THREADS
+    tron_read_end(self);
+    errno = saved_errno; /* unlocking may clobber it */
+    return json;
+}
+
+/* Encodes into out, NUL terminator included; -1 with errno ENOBUFS when it does not fit. */
+static int64_t tron_json_enc_buf(TronObject *self, size_t ofs, bool pretty, char *out, size_t outsz)
+{
+    int64_t written = -1;
+    int saved_errno = 0;
+    tron_read_begin(self);
+    Py_BEGIN_ALLOW_THREADS
+    errno = 0;
+    if (pretty) {
+        written = lite3_json_enc_pretty_buf(self->ctx->buf, self->ctx->buflen, ofs, out, outsz);
+    } else {
+        written = lite3_json_enc_buf(self->ctx->buf, self->ctx->buflen, ofs, out, outsz);
+    }
+    saved_errno = errno;
+    Py_END_ALLOW_THREADS
+    tron_read_end(self);
+    errno = saved_errno; /* callers test for ENOBUFS after the unlock */
+    return written;
+}
+
+static int tron_parse_json_args(tron_argparser *parser, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames,
+                                PyObject **argv, Py_ssize_t *ofs, int *pretty)
+{
+    if (tron_parse_args(parser, args, nargs, kwnames, argv) < 0) {
+        return -1;
+    }
+    if (tron_arg_ssize(argv[0], ofs) < 0 || tron_arg_bool(argv[1], pretty) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *Tron_to_json(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_json", 0, "ofs", "pretty");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    int pretty = 0;
+
+    if (tron_parse_json_args(&parser, args, nargs, kwnames, argv, &ofs, &pretty) < 0) {
+        return NULL;
+    }
+
+    size_t out_len = 0;
+    char *json = tron_json_enc(self, (size_t)ofs, pretty, &out_len);
+    if (!json) {
+        return tron_raise_errno("lite3_ctx_json_enc");
+    }
+
+    PyObject *result = PyUnicode_FromStringAndSize(json, (Py_ssize_t)out_len);
+    free(json);
+    return result;
+}
+
+/* Compact JSON is rarely longer than the Lite3 buffer, so it is first encoded straight
+ * into a bytes object of that size; only an overflow pays for the malloc'd copy. */
+static PyObject *Tron_to_json_bytes(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_json_bytes", 0, "ofs", "pretty");
+    PyObject *argv[2];
+    Py_ssize_t ofs = 0;
+    int pretty = 0;
+
+    if (tron_parse_json_args(&parser, args, nargs, kwnames, argv, &ofs, &pretty) < 0) {
+        return NULL;
+    }
+
+    Py_ssize_t guess = (Py_ssize_t)self->ctx->buflen + 256;
+    PyObject *result = PyBytes_FromStringAndSize(NULL, guess);
+    if (!result) {
+        return NULL;
+    }
+    /* PyBytes keeps a spare byte for the terminator. */
+    int64_t written = tron_json_enc_buf(self, (size_t)ofs, pretty, PyBytes_AS_STRING(result), (size_t)guess + 1);
+    if (written >= 0) {
+        if (_PyBytes_Resize(&result, (Py_ssize_t)written) < 0) {
+            return NULL;
+        }
+        return result;
+    }
+    Py_DECREF(result);
+    if (errno != ENOBUFS) {
+        return tron_raise_errno("lite3_json_enc_buf");
+    }
+
+    size_t out_len = 0;
+    char *json = tron_json_enc(self, (size_t)ofs, pretty, &out_len);
+    if (!json) {
+        return tron_raise_errno("lite3_ctx_json_enc");
+    }
+    result = PyBytes_FromStringAndSize(json, (Py_ssize_t)out_len);
+    free(json);
+    return result;
+}
+
+static PyObject *Tron_to_json_into(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_json_into", 1, "buffer", "ofs", "pretty");
+    PyObject *argv[3];
+    Py_ssize_t ofs = 0;
+    int pretty = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0 || tron_arg_bool(argv[2], &pretty) < 0) {
+        return NULL;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(argv[0], &view, PyBUF_WRITABLE) < 0) {
+        return NULL;
+    }
+    int64_t written = tron_json_enc_buf(self, (size_t)ofs, pretty, (char *)view.buf, (size_t)view.len);
+    PyBuffer_Release(&view);
+
+    if (written < 0) {
+        return tron_raise_errno("lite3_json_enc_buf");
+    }
+    return PyLong_FromLongLong(written);
+}
+
+/* Writes json[0:len] to fd or fileobj.write() in chunk_size slices; a fileobj sees
+ * read-only memoryviews over the encoder's buffer, so no slice is copied. */
+static int tron_write_chunks(PyObject *target, int fd, const char *json, size_t len, size_t chunk_size)
+{
+    size_t pos = 0;
+    while (pos < len) {
+        size_t want = len - pos < chunk_size ? len - pos : chunk_size;
+        Py_ssize_t wrote = 0;
+
+        if (fd >= 0) {
+#ifdef _WIN32
+            PyErr_SetString(PyExc_NotImplementedError, "dump_json to a file descriptor is not supported on this platform");
+            return -1;
+#else
+            Py_BEGIN_ALLOW_THREADS
+            wrote = write(fd, json + pos, want);
+            Py_END_ALLOW_THREADS
+            if (wrote < 0) {
+                if (errno == EINTR && PyErr_CheckSignals() == 0) {
+                    continue;
+                }
+                if (!PyErr_Occurred()) {
+                    tron_raise_errno("write");
+                }
+                return -1;
+            }
+#endif
+        } else {
+            PyObject *chunk = PyMemoryView_FromMemory((char *)json + pos, (Py_ssize_t)want, PyBUF_READ);
+            if (!chunk) {
+                return -1;
+            }
+            PyObject *result = PyObject_CallMethod(target, "write", "O", chunk);
+            PyObject *released = PyObject_CallMethod(chunk, "release", NULL);
+            Py_DECREF(chunk);
+            if (!released) {
+                Py_XDECREF(result);
+                return -2;
+            }
+            Py_DECREF(released);
+            if (!result) {
+                return -1;
+            }
+            /* None is a non-blocking raw stream that wrote nothing; retrying would spin. */
+            if (result == Py_None) {
+                Py_DECREF(result);
+                PyErr_SetString(PyExc_BlockingIOError, "write() returned None: the file would block");
+                return -1;
+            }
+            wrote = PyLong_AsSsize_t(result);
+            Py_DECREF(result);
+            if (wrote < 0 && PyErr_Occurred()) {
+                return -1;
+            }
+            if (wrote < 0 || (size_t)wrote > want) {
+                PyErr_Format(PyExc_OSError, "write() returned %zd for a %zu-byte chunk", wrote, want);
+                return -1;
+            }
+        }
+        pos += (size_t)wrote;
+    }
+    return 0;
+}
+
+static PyObject *Tron_dump_json(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "dump_json", 1, "file", "ofs", "pretty", "chunk_size");
+    PyObject *argv[4];
+    Py_ssize_t ofs = 0;
+    int pretty = 0;
+    Py_ssize_t chunk_size = 1 << 20;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &ofs) < 0 || tron_arg_bool(argv[2], &pretty) < 0 ||
+        tron_arg_ssize(argv[3], &chunk_size) < 0) {
+        return NULL;
+    }
+    if (chunk_size <= 0) {
+        PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+        return NULL;
+    }
+
+    int fd = -1;
+    if (PyLong_Check(argv[0])) {
+        fd = PyLong_AsInt(argv[0]);
+        if (fd == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (fd < 0) {
+            PyErr_SetString(PyExc_ValueError, "file descriptor must be non-negative");
+            return NULL;
+        }
+    }
+
+    size_t out_len = 0;
+    char *json = tron_json_enc(self, (size_t)ofs, pretty, &out_len);
+    if (!json) {
+        return tron_raise_errno("lite3_ctx_json_enc");
+    }
+
+    int ret = tron_write_chunks(argv[0], fd, json, out_len, (size_t)chunk_size);
+    /* -2: a memoryview over json is still exported; leak it rather than free live memory. */
+    if (ret != -2) {
+        free(json);
+    }
+    if (ret < 0) {
+        return NULL;
+    }
+    return PyLong_FromSize_t(out_len);
+}
+
+static PyObject *tron_node_to_obj(const unsigned char *buf, size_t buflen, size_t ofs);
+
+static PyObject *tron_val_to_obj(const unsigned char *buf, size_t buflen, const lite3_val *val)
+{
+    enum lite3_type type = lite3_val_type(val);
+    switch (type) {
+    case LITE3_TYPE_NULL:
+        Py_RETURN_NONE;
+    case LITE3_TYPE_BOOL:
+        return PyBool_FromLong(lite3_val_bool(val) ? 1 : 0);
+    case LITE3_TYPE_I64:
+        return PyLong_FromLongLong((long long)lite3_val_i64(val));
+    case LITE3_TYPE_F64:
+        return PyFloat_FromDouble(lite3_val_f64(val));
+    case LITE3_TYPE_STRING: {
+        size_t len = 0;
+        const char *str = lite3_val_str_n(val, &len);
+        return PyUnicode_FromStringAndSize(str, (Py_ssize_t)len);
+    }
+    case LITE3_TYPE_BYTES: {
+        size_t len = 0;
+        const unsigned char *bytes = lite3_val_bytes(val, &len);
+        return PyBytes_FromStringAndSize((const char *)bytes, (Py_ssize_t)len);
+    }
+    case LITE3_TYPE_OBJECT:
+    case LITE3_TYPE_ARRAY:
+        return tron_node_to_obj(buf, buflen, (size_t)((const unsigned char *)val - buf));
+    default:
+        PyErr_SetString(TronError, "unknown value type");
+        return NULL;
+    }
+}
+
+static PyObject *tron_node_to_obj(const unsigned char *buf, size_t buflen, size_t ofs)
+{
+    if (ofs >= buflen) {
+        errno = EINVAL;
+        return tron_raise_errno("lite3_iter_create");
+    }
+
+    enum lite3_type type = lite3_val_type((const lite3_val *)(buf + ofs));
+    if (type != LITE3_TYPE_OBJECT && type != LITE3_TYPE_ARRAY) {
+        PyErr_SetString(TronError, "offset does not point to an object or array");
+        return NULL;
+    }
+
+    uint32_t count = 0;
+    if (lite3_count(buf, buflen, ofs, &count) < 0) {
+        return tron_raise_errno("lite3_count");
+    }
+
+    lite3_iter iter;
+    if (lite3_iter_create(buf, buflen, ofs, &iter) < 0) {
+        return tron_raise_errno("lite3_iter_create");
+    }
+
+    if (Py_EnterRecursiveCall(" while converting TRON to Python")) {
+        return NULL;
+    }
+
+    bool is_obj = type == LITE3_TYPE_OBJECT;
+    PyObject *result = is_obj ? PyDict_New() : PyList_New((Py_ssize_t)count);
+    if (!result) {
+        Py_LeaveRecursiveCall();
+        return NULL;
+    }
+
+    Py_ssize_t index = 0;
+    lite3_str key;
+    size_t val_ofs = 0;
+    int ret;
+    while ((ret = lite3_iter_next(buf, buflen, &iter, is_obj ? &key : NULL, &val_ofs)) == LITE3_ITER_ITEM) {
+        PyObject *value = tron_val_to_obj(buf, buflen, (const lite3_val *)(buf + val_ofs));
+        if (!value) {
+            goto error;
+        }
+
+        if (!is_obj) {
+            if (index >= (Py_ssize_t)count) {
+                Py_DECREF(value);
+                PyErr_SetString(TronError, "array length changed during iteration");
+                goto error;
+            }
+            PyList_SET_ITEM(result, index++, value);
+            continue;
+        }
+
+        const char *key_str = LITE3_STR(buf, key);
+        if (!key_str) {
+            Py_DECREF(value);
+            PyErr_SetString(TronError, "stale string reference");
+            goto error;
+        }
+
+        PyObject *key_obj = PyUnicode_FromStringAndSize(key_str, (Py_ssize_t)key.len);
+        if (!key_obj) {
+            Py_DECREF(value);
+            goto error;
+        }
+
+        int set_ret = PyDict_SetItem(result, key_obj, value);
+        Py_DECREF(key_obj);
+        Py_DECREF(value);
+        if (set_ret < 0) {
+            goto error;
+        }
+    }
+
+    if (ret < 0) {
+        tron_raise_errno("lite3_iter_next");
+        goto error;
+    }
+
+    if (!is_obj && index != (Py_ssize_t)count) {
+        PyErr_SetString(TronError, "array length changed during iteration");
+        goto error;
+    }
+
+    Py_LeaveRecursiveCall();
+    return result;
+
+error:
+    Py_LeaveRecursiveCall();
+    Py_DECREF(result);
+    return NULL;
+}
+
+static PyObject *Tron_to_obj(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_obj", 0, "ofs");
+    PyObject *argv[1];
+    Py_ssize_t ofs = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[0], &ofs) < 0) {
+        return NULL;
+    }
+
+    return tron_node_to_obj(self->ctx->buf, self->ctx->buflen, (size_t)ofs);
+}
+enum tron_iter_kind {
+    TRON_ITER_KEYS,
+    TRON_ITER_VALUES,
+    TRON_ITER_ITEMS,
+};
+
+/* Lazy cursor over one object/array: holds no Python values, only the lite3 iterator. */
+typedef struct {
+    PyObject_HEAD
+    TronObject *tron;
+    lite3_iter iter;
+    uint64_t version;
+    enum tron_iter_kind kind;
+    bool views; /* yield TronDict/TronList for containers instead of offsets */
+    bool done;
+} TronIterObject;
+
+/* Lazy TronDict/TronList proxy over the container at (tron, ofs). ofs is only meaningful
+ * for the tron->version it was taken at: any write may move or drop the node. */
+typedef struct {
+    PyObject_HEAD
+    TronObject *tron;
+    size_t ofs;
+    uint64_t version;
+} TronViewObject;
+
+static PyTypeObject TronIterType;
+static PyTypeObject TronDictType;
+static PyTypeObject TronListType;
+static PyObject *tron_val_to_view(TronObject *tron, const lite3_val *val);
+
+static PyObject *tron_iter_new(TronObject *tron, size_t ofs, enum tron_iter_kind kind, bool views)
+{
+    const unsigned char *buf = tron->ctx->buf;
+    size_t buflen = tron->ctx->buflen;
+
+    if (kind == TRON_ITER_VALUES) {
+        if (ofs >= buflen) {
+            errno = EINVAL;
+            return tron_raise_errno("lite3_iter_create");
+        }
+        enum lite3_type type = lite3_val_type((const lite3_val *)(buf + ofs));
+        if (type != LITE3_TYPE_OBJECT && type != LITE3_TYPE_ARRAY) {
+            PyErr_SetString(TronError, "offset does not point to an object or array");
+            return NULL;
+        }
+    } else if (_lite3_verify_obj_get(buf, buflen, ofs) < 0) {
+        PyErr_SetString(TronError, "keys()/items() need an object offset");
+        return NULL;
+    }
+
+    TronIterObject *it = PyObject_New(TronIterObject, &TronIterType);
+    if (!it) {
+        return NULL;
+    }
+    it->tron = (TronObject *)Py_NewRef(tron);
+    it->version = tron->version;
+    it->kind = kind;
+    it->views = views;
+    it->done = false;
+
+    if (lite3_iter_create(buf, buflen, ofs, &it->iter) < 0) {
+        Py_DECREF(it);
+        return tron_raise_errno("lite3_iter_create");
+    }
+    return (PyObject *)it;
+}
+
+/* Shared by the methods whose only parameter is ofs. */
+static int tron_parse_ofs(tron_argparser *parser, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames, Py_ssize_t *ofs)
+{
+    PyObject *argv[1];
+    if (tron_parse_args(parser, args, nargs, kwnames, argv) < 0) {
+        return -1;
+    }
+    return tron_arg_ssize(argv[0], ofs);
+}
+
+static PyObject *Tron_keys(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "keys", 0, "ofs");
+    Py_ssize_t ofs = 0;
+    if (tron_parse_ofs(&parser, args, nargs, kwnames, &ofs) < 0) {
+        return NULL;
+    }
+    return tron_iter_new(self, (size_t)ofs, TRON_ITER_KEYS, false);
+}
+
+static PyObject *Tron_values(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "values", 0, "ofs");
+    Py_ssize_t ofs = 0;
+    if (tron_parse_ofs(&parser, args, nargs, kwnames, &ofs) < 0) {
+        return NULL;
+    }
+    return tron_iter_new(self, (size_t)ofs, TRON_ITER_VALUES, false);
+}
+
+static PyObject *Tron_items(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "items", 0, "ofs");
+    Py_ssize_t ofs = 0;
+    if (tron_parse_ofs(&parser, args, nargs, kwnames, &ofs) < 0) {
+        return NULL;
+    }
+    return tron_iter_new(self, (size_t)ofs, TRON_ITER_ITEMS, false);
+}
+
+static PyObject *Tron_count(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "count", 0, "ofs");
+    Py_ssize_t ofs = 0;
+    if (tron_parse_ofs(&parser, args, nargs, kwnames, &ofs) < 0) {
+        return NULL;
+    }
+
+    uint32_t count = 0;
+    if (lite3_count(self->ctx->buf, self->ctx->buflen, (size_t)ofs, &count) < 0) {
+        return tron_raise_errno("lite3_count");
+    }
+    return PyLong_FromUnsignedLong(count);
+}
+
+static bool tron_root_is_arr(const TronObject *self)
+{
+    return lite3_val_type((const lite3_val *)self->ctx->buf) == LITE3_TYPE_ARRAY;
+}
+
+static Py_ssize_t Tron_length(TronObject *self)
+{
+    uint32_t count = 0;
+    if (lite3_count(self->ctx->buf, self->ctx->buflen, 0, &count) < 0) {
+        tron_raise_errno("lite3_count");
+        return -1;
+    }
+    return (Py_ssize_t)count;
+}
+
+static PyObject *Tron_iter(TronObject *self)
+{
+    return tron_iter_new(self, 0, tron_root_is_arr(self) ? TRON_ITER_VALUES : TRON_ITER_KEYS, false);
+}
+
+/* tron[i] on an array root, tron[key] / tron[path] on an object root; containers come
+ * back as offsets, like get(). */
+static PyObject *Tron_subscript(TronObject *self, PyObject *item)
+{
+    lite3_val *val = NULL;
+
+    if (PyLong_Check(item)) {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        Py_ssize_t count = tron_root_is_arr(self) ? Tron_length(self) : -1;
+        if (count < 0) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError, "integer indexes need an array root");
+            }
+            return NULL;
+        }
+        if (index < 0) {
+            index += count;
+        }
+        if (index < 0 || index >= count) {
+            PyErr_SetString(PyExc_IndexError, "Tron array index out of range");
+            return NULL;
+        }
+        if (tron_ctx_arr_get(self->ctx, 0, (uint32_t)index, &val) < 0) {
+            return tron_raise_errno("lite3_arr_get");
+        }
+        return tron_val_to_py(self->ctx, val);
+    }
+
+    if (Py_IS_TYPE(item, &PathType)) {
+        PathObject *path = (PathObject *)item;
+        Py_ssize_t failed_at = 0;
+        errno = 0;
+        if (tron_path_walk(self->ctx, 0, path->segs, Py_SIZE(path), &val, &failed_at) < 0) {
+            if (errno == ENOENT) {
+                PyErr_SetObject(PyExc_KeyError, item);
+                return NULL;
+            }
+            return tron_raise_path(path, failed_at);
+        }
+        return tron_val_to_py(self->ctx, val);
+    }
+
+    tron_key key;
+    if (tron_arg_key(item, &key) < 0) {
+        return NULL;
+    }
+    errno = 0;
+    if (tron_ctx_get(self->ctx, 0, &key, &val) < 0) {
+        if (errno == ENOENT) {
+            PyErr_SetObject(PyExc_KeyError, item);
+            return NULL;
+        }
+        return tron_raise_errno("lite3_get_impl");
+    }
+    return tron_val_to_py(self->ctx, val);
+}
+
+/* 1 present, 0 absent, -1 error; -2 for an array root, which has no keys to look up. */
+static int Tron_contains_key(TronObject *self, PyObject *item)
+{
+    if (tron_root_is_arr(self)) {
+        return -2;
+    }
+    if (!PyUnicode_Check(item) && !Py_IS_TYPE(item, &KeyType)) {
+        return 0;
+    }
+    tron_key key;
+    if (tron_arg_key(item, &key) < 0) {
+        return -1;
+    }
+    lite3_val *val = NULL;
+    errno = 0;
+    if (tron_ctx_get(self->ctx, 0, &key, &val) == 0) {
+        return 1;
+    }
+    if (errno == ENOENT) {
+        return 0;
+    }
+    tron_raise_errno("lite3_get_impl");
+    return -1;
+}
+
+TRON_LOCKED(Py_ssize_t, -1, Tron_length, self, (TronObject *self), (self))
+TRON_LOCKED(PyObject *, NULL, Tron_subscript, self, (TronObject *self, PyObject *item), (self, item))
+TRON_LOCKED(PyObject *, NULL, Tron_iter, self, (TronObject *self), (self))
+TRON_LOCKED(int, -1, Tron_contains_key, self, (TronObject *self, PyObject *item), (self, item))
+
+/* `key in tron` is one hashed lookup on an object root. An array root keeps the scan over
+ * its values that iteration gives, comparing outside the lock as iteration does. */
+static int Tron_contains(TronObject *self, PyObject *item)
+{
+    int found = Tron_contains_key_locked(self, item);
+    if (found != -2) {
+        return found;
+    }
+
+    PyObject *it = Tron_iter_locked(self);
+    if (!it) {
+        return -1;
+    }
+    PyObject *value;
+    found = 0;
+    while (!found && (value = PyIter_Next(it)) != NULL) {
+        found = PyObject_RichCompareBool(value, item, Py_EQ);
+        Py_DECREF(value);
+    }
+    Py_DECREF(it);
+    return found < 0 || PyErr_Occurred() ? -1 : found;
+}
+
+static PyMappingMethods Tron_as_mapping = {
+    .mp_length = (lenfunc)Tron_length_locked,
+    .mp_subscript = (binaryfunc)Tron_subscript_locked,
+};
+
+static PySequenceMethods Tron_as_sequence = {
+    .sq_contains = (objobjproc)Tron_contains,
+};
+
+/* collections.abc view classes, so TronDict.keys()/values()/items() honour the Mapping contract. */
+static PyObject *AbcKeysView;
+static PyObject *AbcValuesView;
+static PyObject *AbcItemsView;
+
+static PyObject *tron_view_new(TronObject *tron, size_t ofs, enum lite3_type type)
+{
+    TronViewObject *view = PyObject_New(TronViewObject, type == LITE3_TYPE_OBJECT ? &TronDictType : &TronListType);
+    if (!view) {
+        return NULL;
+    }
+    view->tron = (TronObject *)Py_NewRef(tron);
+    view->ofs = ofs;
+    view->version = tron->version;
+    return (PyObject *)view;
+}
+
+static PyObject *tron_val_to_view(TronObject *tron, const lite3_val *val)
+{
+    enum lite3_type type = lite3_val_type(val);
+    if (type == LITE3_TYPE_OBJECT || type == LITE3_TYPE_ARRAY) {
+        return tron_view_new(tron, tron_val_ofs(tron->ctx, val), type);
+    }
+    return tron_val_to_py(tron->ctx, val);
+}
+
+static PyObject *Tron_view(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "view", 0, "ofs");
+    Py_ssize_t ofs = 0;
+    if (tron_parse_ofs(&parser, args, nargs, kwnames, &ofs) < 0) {
+        return NULL;
+    }
+
+    if ((size_t)ofs >= self->ctx->buflen) {
+        errno = EINVAL;
+        return tron_raise_errno("view");
+    }
+    enum lite3_type type = lite3_val_type((const lite3_val *)(self->ctx->buf + ofs));
+    if (type != LITE3_TYPE_OBJECT && type != LITE3_TYPE_ARRAY) {
+        PyErr_SetString(TronError, "offset does not point to an object or array");
+        return NULL;
+    }
+    return tron_view_new(self, (size_t)ofs, type);
+}
+
+
+static PyObject *Tron_save(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "save", 1, "path");
+    PyObject *argv[1];
+    const char *path = NULL;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_cstr(argv[0], &path) < 0) {
+        return NULL;
+    }
+
+    const char *failed = NULL;
+    tron_read_begin(self);
+    Py_BEGIN_ALLOW_THREADS
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        failed = "fopen";
+    } else {
+        size_t written = fwrite(self->ctx->buf, 1, self->ctx->buflen, fp);
+        int saved_errno = errno;
+        fclose(fp);
+        if (written != self->ctx->buflen) {
+            errno = saved_errno;
+            failed = "fwrite";
+        }
+    }
+    Py_END_ALLOW_THREADS
+    tron_read_end(self);
+
+    if (failed) {
+        return tron_raise_errno(failed);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Tron_freeze(TronObject *self, PyObject *Py_UNUSED(args))
+{
+    if (Py_IS_TYPE(self, &FrozenTronType)) {
+        return Py_NewRef(self);
+    }
+
+    lite3_ctx *ctx = lite3_ctx_create_from_buf(self->ctx->buf, self->ctx->buflen);
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create_from_buf");
+    }
+    TronObject *frozen = tron_create_with_ctx(&FrozenTronType, ctx);
+    if (!frozen) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+    return (PyObject *)frozen;
+}
+
+static PyObject *Tron_debug_fill(TronObject *self, PyObject *arg)
+{
+    unsigned long value = 0;
+    if (tron_arg_ulong(arg, &value) < 0) {
+        return NULL;
+    }
+
+    if (tron_check_mutable(self) < 0) {
+        return NULL;
+    }
+
+    memset(self->ctx->buf, (int)(value & 0xFF), self->ctx->bufsz);
+    Py_RETURN_NONE;
+}
+
+/* FrozenTron over view->buf[offset:offset+length] without copying; takes ownership of
+ * the view, which stays acquired (pinning its exporter) until the FrozenTron is freed.
+ * Writable views are copied unless borrow_writable, where the caller vouches that nothing
+ * writes the memory for the FrozenTron's lifetime. */
+static PyObject *tron_frozen_from_view(Py_buffer *view, Py_ssize_t offset, Py_ssize_t length, bool borrow_writable)
+{
+    if (length < 0) {
+        length = view->len - offset;
+    }
+    if (offset < 0 || length <= 0 || offset > view->len - length) {
+        PyErr_Format(PyExc_ValueError, "offset %zd, length %zd out of range for a %zd-byte buffer",
+                     offset, length, view->len);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+    unsigned char *buf = (unsigned char *)view->buf + offset;
+
+    /* A writable exporter could change the bytes under the cached hash and the lock-free
+     * readers, so its contents are copied into a private ctx instead of borrowed. */
+    if (view->readonly == 0 && !borrow_writable) {
+        lite3_ctx *copy = lite3_ctx_create_from_buf(buf, (size_t)length);
+        PyBuffer_Release(view);
+        if (!copy) {
+            return tron_raise_errno("lite3_ctx_create_from_buf");
+        }
+        TronObject *self = tron_create_with_ctx(&FrozenTronType, copy);
+        if (!self) {
+            lite3_ctx_destroy(copy);
+        }
+        return (PyObject *)self;
+    }
+
+    if ((uintptr_t)buf % LITE3_NODE_ALIGNMENT != 0) {
+        PyErr_Format(PyExc_ValueError, "buffer at offset %zd is not %d-byte aligned", offset, LITE3_NODE_ALIGNMENT);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+
+    lite3_ctx *ctx = tron_ctx_wrap(buf, (size_t)length);
+    if (!ctx) {
+        PyBuffer_Release(view);
+        return NULL;
+    }
+
+    TronObject *self = tron_create_with_ctx(&FrozenTronType, ctx);
+    if (!self) {
+        tron_ctx_unwrap(ctx);
+        PyBuffer_Release(view);
+        return NULL;
+    }
+    self->source = *view;
+    return (PyObject *)self;
+}
+
+static PyObject *Tron_from_bytes(PyTypeObject *type, PyObject *data)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+
+    lite3_ctx *ctx = lite3_ctx_create_from_buf((const unsigned char *)view.buf, (size_t)view.len);
+    PyBuffer_Release(&view);
+
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create_from_buf");
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+/* tron._tron._unpickle, looked up once in tron_exec for __reduce_ex__. */
+static PyObject *TronUnpickle;
+
+/* Pickle reconstructor. A FrozenTron is rebuilt zero-copy over the unpickled buffer
+ * (in-band bytes or the out-of-band PickleBuffer), a Tron copies it once. */
+static PyObject *tron_unpickle(PyObject *Py_UNUSED(module), PyObject *const *args, Py_ssize_t nargs)
+{
+    if (nargs != 2) {
+        PyErr_SetString(PyExc_TypeError, "_unpickle expects (buffer, frozen)");
+        return NULL;
+    }
+    int frozen = PyObject_IsTrue(args[1]);
+    if (frozen < 0) {
+        return NULL;
+    }
+    if (!frozen) {
+        return Tron_from_bytes(&TronType, args[0]);
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(args[0], &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    if ((uintptr_t)view.buf % LITE3_NODE_ALIGNMENT == 0) {
+        return tron_frozen_from_view(&view, 0, -1, false);
+    }
+    lite3_ctx *ctx = lite3_ctx_create_from_buf((const unsigned char *)view.buf, (size_t)view.len);
+    PyBuffer_Release(&view);
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create_from_buf");
+    }
+    TronObject *self = tron_create_with_ctx(&FrozenTronType, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+    }
+    return (PyObject *)self;
+}
+
+/* Protocol 5 pickles a PickleBuffer over buf[0:buflen], which pickle can hand out of
+ * band (buffer_callback) instead of copying into the stream. */
+static PyObject *Tron_reduce_ex(TronObject *self, PyObject *arg)
+{
+    int protocol = PyLong_AsInt(arg);
+    if (protocol == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    PyObject *data = protocol >= 5 ? PyPickleBuffer_FromObject((PyObject *)self)
+                                   : PyBytes_FromStringAndSize((const char *)self->ctx->buf, (Py_ssize_t)self->ctx->buflen);
+    if (!data) {
+        return NULL;
+    }
+    PyObject *frozen = PyObject_TypeCheck(self, &FrozenTronType) ? Py_True : Py_False;
+    return Py_BuildValue("O(NO)", TronUnpickle, data, frozen);
+}
+
+/* Shared memory layout: <u64 buflen> then the buffer, so the segment's page rounding
+ * never leaks into buflen. */
+#define TRON_SHM_HEADER 8
+
+static PyObject *Tron_to_shared_memory(TronObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "to_shared_memory", 0, "name");
+    PyObject *argv[1];
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+
+    PyObject *shm_type = tron_import_attr("multiprocessing.shared_memory", "SharedMemory");
+    if (!shm_type) {
+        return NULL;
+    }
+    uint64_t buflen = (uint64_t)self->ctx->buflen;
+    PyObject *shm = PyObject_CallFunction(shm_type, "OOK", argv[0] ? argv[0] : Py_None, Py_True,
+                                          (unsigned long long)(TRON_SHM_HEADER + buflen));
+    Py_DECREF(shm_type);
+    if (!shm) {
+        return NULL;
+    }
+
+    PyObject *buf_obj = PyObject_GetAttrString(shm, "buf");
+    Py_buffer view;
+    if (!buf_obj || PyObject_GetBuffer(buf_obj, &view, PyBUF_WRITABLE) < 0) {
+        Py_XDECREF(buf_obj);
+        goto fail;
+    }
+    Py_DECREF(buf_obj);
+
+    /* SharedMemory() and shm.buf run Python code (and release the GIL), so this Tron may
+     * have been written, re-initialized or released since buflen sized the segment. */
+    tron_read_begin(self);
+    if (!self->ctx || (uint64_t)self->ctx->buflen != buflen) {
+        tron_read_end(self);
+        PyBuffer_Release(&view);
+        if (self->ctx) {
+            PyErr_SetString(PyExc_RuntimeError, "Tron changed size during to_shared_memory()");
+        } else {
+            tron_raise_released();
+        }
+        goto fail;
+    }
+    memcpy(view.buf, &buflen, sizeof(buflen));
+    memcpy((unsigned char *)view.buf + TRON_SHM_HEADER, self->ctx->buf, (size_t)buflen);
+    tron_read_end(self);
+    PyBuffer_Release(&view);
+    return shm;
+
+fail:;
+    PyObject *exc = PyErr_GetRaisedException();
+    PyObject *res = PyObject_CallMethod(shm, "close", NULL);
+    Py_XDECREF(res);
+    res = res ? PyObject_CallMethod(shm, "unlink", NULL) : NULL;
+    Py_XDECREF(res);
+    PyErr_SetRaisedException(exc);
+    Py_DECREF(shm);
+    return NULL;
+}
+
+static PyObject *Tron_from_shared_memory(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "from_shared_memory", 1, "shm", "readonly");
+    PyObject *argv[2];
+    int readonly = 1;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_bool(argv[1], &readonly) < 0) {
+        return NULL;
+    }
+
+    /* A SharedMemory exposes its mapping as .buf; any other buffer is taken as-is. */
+    PyObject *buf_obj = NULL;
+    if (PyObject_GetOptionalAttrString(argv[0], "buf", &buf_obj) < 0) {
+        return NULL;
+    }
+    if (!buf_obj) {
+        buf_obj = Py_NewRef(argv[0]);
+    }
+    Py_buffer view;
+    int ret = PyObject_GetBuffer(buf_obj, &view, PyBUF_SIMPLE);
+    Py_DECREF(buf_obj);
+    if (ret < 0) {
+        return NULL;
+    }
+
+    uint64_t buflen = 0;
+    if (view.len < TRON_SHM_HEADER ||
+        (memcpy(&buflen, view.buf, sizeof(buflen)), buflen == 0 || buflen > (uint64_t)(view.len - TRON_SHM_HEADER))) {
+        PyBuffer_Release(&view);
+        PyErr_SetString(TronError, "shared memory does not hold a Tron written by to_shared_memory()");
+        return NULL;
+    }
+    if (readonly) {
+        /* Shared memory is always writable by its other processes, so this zero-copy
+         * FrozenTron rests on the documented contract that nobody rewrites the segment
+         * while it is attached; its hash and lock-free reads assume exactly that. */
+        return tron_frozen_from_view(&view, TRON_SHM_HEADER, (Py_ssize_t)buflen, true);
+    }
+
+    lite3_ctx *ctx = lite3_ctx_create_from_buf((const unsigned char *)view.buf + TRON_SHM_HEADER, (size_t)buflen);
+    PyBuffer_Release(&view);
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create_from_buf");
+    }
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+    }
+    return (PyObject *)self;
+}
+
+static PyObject *Tron_from_obj(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "from_obj", 1, "obj", "bufsz_hint");
+    PyObject *argv[2];
+    PyObject *obj = NULL;
+    PyObject *bufsz_obj = Py_None;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    obj = argv[0];
+    if (argv[1]) {
+        bufsz_obj = argv[1];
+    }
+
+    bool is_obj = PyDict_Check(obj);
+    if (!is_obj && !PyList_Check(obj) && !PyTuple_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError, "root value must be dict or list");
+        return NULL;
+    }
+
+    Py_ssize_t bufsz = 0;
+    if (bufsz_obj != Py_None) {
+        bufsz = PyLong_AsSsize_t(bufsz_obj);
+        if (bufsz == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (bufsz < 0) {
+            PyErr_SetString(PyExc_ValueError, "bufsz_hint must be non-negative");
+            return NULL;
+        }
+    }
+
+    lite3_ctx *ctx = bufsz > 0 ? lite3_ctx_create_with_size((size_t)bufsz) : lite3_ctx_create();
+    if (!ctx) {
+        return tron_raise_errno("lite3_ctx_create");
+    }
+
+    int ret = is_obj ? lite3_ctx_init_obj(ctx) : lite3_ctx_init_arr(ctx);
+    if (ret < 0) {
+        tron_raise_errno("lite3_ctx_init");
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    if (is_obj) {
+        ret = tron_fill_obj(ctx, 0, obj);
+    } else {
+        PyObject *seq = PySequence_Fast(obj, "expected a list or tuple");
+        if (!seq) {
+            lite3_ctx_destroy(ctx);
+            return NULL;
+        }
+        ret = tron_fill_arr(ctx, 0, seq);
+        Py_DECREF(seq);
+    }
+
+    if (ret < 0) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+/* Initial bufsz for decoding json_len bytes of JSON: the Lite3 encoding of typical
+ * documents lands within a quarter of the JSON size, so decodes grow at most once. */
+static size_t tron_json_presize(size_t json_len)
+{
+    size_t bufsz = json_len + json_len / 4;
+    if (bufsz < LITE3_CONTEXT_BUF_SIZE_MIN) {
+        return LITE3_CONTEXT_BUF_SIZE_MIN;
+    }
+    return bufsz > LITE3_BUF_SIZE_MAX ? LITE3_BUF_SIZE_MAX : bufsz;
+}
+
+/* The decoders below build a fresh, unshared ctx, so they run with the GIL released.
+ * Returns NULL with errno set and *failed naming the call that failed. */
+static lite3_ctx *tron_decode_json(const char *json_str, size_t json_len, const char **failed)
+{
+    lite3_ctx *ctx = lite3_ctx_create_with_size(tron_json_presize(json_len));
+    if (!ctx) {
+        *failed = "lite3_ctx_create_with_size";
+        return NULL;
+    }
+    if (lite3_ctx_json_dec(ctx, json_str, json_len) < 0) {
+        int saved_errno = errno;
+        lite3_ctx_destroy(ctx);
+        errno = saved_errno;
+        *failed = "lite3_ctx_json_dec";
+        return NULL;
+    }
+    return ctx;
+}
+
+/* Accepts str or any bytes-like object; UTF-8 bytes are decoded where they lie instead of
+ * round-tripping through str. */
+static PyObject *Tron_from_json(PyTypeObject *type, PyObject *json_obj)
+{
+    Py_buffer view = {0};
+    Py_ssize_t json_len = 0;
+    const char *json_str = NULL;
+
+    if (PyUnicode_Check(json_obj)) {
+        /* Owned by the immutable str, which the caller keeps alive for the call. */
+        json_str = PyUnicode_AsUTF8AndSize(json_obj, &json_len);
+        if (!json_str) {
+            return NULL;
+        }
+    } else {
+        /* The export pins the buffer (a bytearray cannot resize) while the GIL is released. */
+        if (PyObject_GetBuffer(json_obj, &view, PyBUF_SIMPLE) < 0) {
+            return NULL;
+        }
+        json_str = (const char *)view.buf;
+        json_len = view.len;
+    }
+
+    const char *failed = NULL;
+    lite3_ctx *ctx = NULL;
+    Py_BEGIN_ALLOW_THREADS
+    ctx = tron_decode_json(json_str, (size_t)json_len, &failed);
+    Py_END_ALLOW_THREADS
+    if (view.obj) {
+        PyBuffer_Release(&view);
+    }
+    if (!ctx) {
+        return tron_raise_errno(failed);
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+static PyObject *Tron_from_json_file(PyTypeObject *type, PyObject *path_obj)
+{
+    const char *path = NULL;
+    if (tron_arg_cstr(path_obj, &path) < 0) {
+        return NULL;
+    }
+
+    const char *failed = NULL;
+    lite3_ctx *ctx = NULL;
+    Py_BEGIN_ALLOW_THREADS
+#ifndef _WIN32
+    struct stat st;
+    size_t bufsz = tron_json_presize(stat(path, &st) == 0 ? (size_t)st.st_size : 0);
+#else
+    size_t bufsz = LITE3_CONTEXT_BUF_SIZE_MIN;
+#endif
+    ctx = lite3_ctx_create_with_size(bufsz);
+    if (!ctx) {
+        failed = "lite3_ctx_create_with_size";
+    } else if (lite3_ctx_json_dec_file(ctx, path) < 0) {
+        int saved_errno = errno;
+        lite3_ctx_destroy(ctx);
+        errno = saved_errno;
+        ctx = NULL;
+        failed = "lite3_ctx_json_dec_file";
+    }
+    Py_END_ALLOW_THREADS
+    if (!ctx) {
+        return tron_raise_errno(failed);
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+/* Reads a whole Lite3 file into a new ctx; *failed is NULL with errno 0 for an empty file. */
+static lite3_ctx *tron_read_file(const char *path, const char **failed)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        *failed = "fopen";
+        return NULL;
+    }
+
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) != 0) {
+        *failed = "fseek";
+    } else if ((size = ftell(fp)) < 0) {
+        *failed = "ftell";
+    } else if (fseek(fp, 0, SEEK_SET) != 0) {
+        *failed = "fseek";
+    }
+    if (*failed) {
+        int saved_errno = errno;
+        fclose(fp);
+        errno = saved_errno;
+        return NULL;
+    }
+
+    if (size == 0) {
+        fclose(fp);
+        errno = 0;
+        return NULL;
+    }
+
+    unsigned char *buf = (unsigned char *)malloc((size_t)size);
+    if (!buf) {
+        fclose(fp);
+        *failed = "malloc";
+        return NULL;
+    }
+
+    size_t read = fread(buf, 1, (size_t)size, fp);
+    int saved_errno = errno;
+    fclose(fp);
+
+    if (read != (size_t)size) {
+        free(buf);
+        errno = saved_errno;
+        *failed = "fread";
+        return NULL;
+    }
+
+    lite3_ctx *ctx = lite3_ctx_create_from_buf(buf, (size_t)size);
+    saved_errno = errno;
+    free(buf);
+    if (!ctx) {
+        errno = saved_errno;
+        *failed = "lite3_ctx_create_from_buf";
+    }
+    return ctx;
+}
+
+static PyObject *Tron_from_file(PyTypeObject *type, PyObject *path_obj)
+{
+    const char *path = NULL;
+    if (tron_arg_cstr(path_obj, &path) < 0) {
+        return NULL;
+    }
+
+    const char *failed = NULL;
+    lite3_ctx *ctx = NULL;
+    Py_BEGIN_ALLOW_THREADS
+    ctx = tron_read_file(path, &failed);
+    Py_END_ALLOW_THREADS
+
+    if (!ctx) {
+        if (!failed) {
+            PyErr_SetString(TronError, "file is empty");
+            return NULL;
+        }
+        return tron_raise_errno(failed);
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    return (PyObject *)self;
+}
+
+static PyObject *Tron_open_mmap(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "open_mmap", 1, "path", "copy_on_write");
+    PyObject *argv[2];
+    const char *path = NULL;
+    int copy_on_write = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_cstr(argv[0], &path) < 0 || tron_arg_bool(argv[1], &copy_on_write) < 0) {
+        return NULL;
+    }
+
+#ifdef _WIN32
+    PyErr_SetString(PyExc_NotImplementedError, "open_mmap is not supported on this platform");
+    return NULL;
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return tron_raise_errno("open");
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int saved_errno = errno;
+        close(fd);
+        errno = saved_errno;
+        return tron_raise_errno("fstat");
+    }
+
+    if (st.st_size == 0) {
+        close(fd);
+        PyErr_SetString(TronError, "file is empty");
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void *addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int saved_errno = errno;
+    close(fd);
+
+    if (addr == MAP_FAILED) {
+        errno = saved_errno;
+        return tron_raise_errno("mmap");
+    }
+
+    /* Pages are only faulted in as lookups touch them; nothing is copied. */
+    lite3_ctx *ctx = tron_ctx_wrap((const unsigned char *)addr, size);
+    if (!ctx) {
+        munmap(addr, size);
+        return NULL;
+    }
+
+    TronObject *self = tron_create_with_ctx(type, ctx);
+    if (!self) {
+        tron_ctx_unwrap(ctx);
+        munmap(addr, size);
+        return NULL;
+    }
+
+    self->mapping = (unsigned char *)addr;
+    self->mapping_len = size;
+    self->copy_on_write = copy_on_write != 0;
+    return (PyObject *)self;
+#endif
+}
+
+TRON_LOCKED_O(Tron_init_obj)
+TRON_LOCKED_O(Tron_init_arr)
+TRON_LOCKED_FASTCALL(Tron_reset)
+TRON_LOCKED_FASTCALL(Tron_set_null)
+TRON_LOCKED_FASTCALL(Tron_set_bool)
+TRON_LOCKED_FASTCALL(Tron_set_i64)
+TRON_LOCKED_FASTCALL(Tron_set_f64)
+TRON_LOCKED_FASTCALL(Tron_set_bytes)
+TRON_LOCKED_FASTCALL(Tron_set_str)
+TRON_LOCKED_FASTCALL(Tron_set_obj)
+TRON_LOCKED_FASTCALL(Tron_set_arr)
+TRON_LOCKED_FASTCALL(Tron_set_many)
+TRON_LOCKED_FASTCALL(Tron_get_bool)
+TRON_LOCKED_FASTCALL(Tron_get_i64)
+TRON_LOCKED_FASTCALL(Tron_get_f64)
+TRON_LOCKED_FASTCALL(Tron_get_bytes)
+TRON_LOCKED_FASTCALL(Tron_get_str)
+TRON_LOCKED_FASTCALL(Tron_get_obj)
+TRON_LOCKED_FASTCALL(Tron_get_arr)
+TRON_LOCKED_FASTCALL(Tron_get_type)
+TRON_LOCKED_FASTCALL(Tron_get)
+TRON_LOCKED_FASTCALL(Tron_get_path)
+TRON_LOCKED_FASTCALL(Tron_set_path)
+TRON_LOCKED_FASTCALL(Tron_get_many)
+TRON_LOCKED_FASTCALL(Tron_extract)
+TRON_LOCKED_FASTCALL(Tron_exists)
+TRON_LOCKED_FASTCALL(Tron_arr_append_null)
+TRON_LOCKED_FASTCALL(Tron_arr_append_bool)
+TRON_LOCKED_FASTCALL(Tron_arr_append_i64)
+TRON_LOCKED_FASTCALL(Tron_arr_append_f64)
+TRON_LOCKED_FASTCALL(Tron_arr_append_bytes)
+TRON_LOCKED_FASTCALL(Tron_arr_append_str)
+TRON_LOCKED_FASTCALL(Tron_arr_append_obj)
+TRON_LOCKED_FASTCALL(Tron_arr_append_arr)
+TRON_LOCKED_FASTCALL(Tron_arr_get_bool)
+TRON_LOCKED_FASTCALL(Tron_arr_get_i64)
+TRON_LOCKED_FASTCALL(Tron_arr_get_f64)
+TRON_LOCKED_FASTCALL(Tron_arr_get_bytes)
+TRON_LOCKED_FASTCALL(Tron_arr_get_str)
+TRON_LOCKED_FASTCALL(Tron_arr_get_obj)
+TRON_LOCKED_FASTCALL(Tron_arr_get_arr)
+TRON_LOCKED_FASTCALL(Tron_arr_extend_i64)
+TRON_LOCKED_FASTCALL(Tron_arr_extend_f64)
+TRON_LOCKED_FASTCALL(Tron_arr_to_buffer)
+TRON_LOCKED_FASTCALL(Tron_to_columns)
+TRON_LOCKED_FASTCALL(Tron_extend_columns)
+TRON_LOCKED_FASTCALL(Tron_select)
+TRON_LOCKED_O(Tron_to_bytes)
+TRON_LOCKED_O(Tron_buflen)
+TRON_LOCKED_O(Tron_bufsz)
+TRON_LOCKED_FASTCALL(Tron_to_json)
+TRON_LOCKED_FASTCALL(Tron_to_json_bytes)
+TRON_LOCKED_FASTCALL(Tron_to_json_into)
+TRON_LOCKED_FASTCALL(Tron_dump_json)
+TRON_LOCKED_FASTCALL(Tron_keys)
+TRON_LOCKED_FASTCALL(Tron_values)
+TRON_LOCKED_FASTCALL(Tron_items)
+TRON_LOCKED_FASTCALL(Tron_count)
+TRON_LOCKED_FASTCALL(Tron_to_obj)
+TRON_LOCKED_FASTCALL(Tron_view)
+TRON_LOCKED_FASTCALL(Tron_save)
+TRON_LOCKED_O(Tron_freeze)
+TRON_LOCKED_O(Tron_reduce_ex)
+TRON_LOCKED_FASTCALL(Tron_to_shared_memory)
+TRON_LOCKED_O(Tron_debug_fill)
+
+static PyMethodDef Tron_methods[] = {
+    {"init_obj", (PyCFunction)Tron_init_obj_locked, METH_NOARGS, "Initialize root as object."},
+    {"init_arr", (PyCFunction)Tron_init_arr_locked, METH_NOARGS, "Initialize root as array."},
+    {"reset", (PyCFunction)Tron_reset_locked, METH_FASTCALL | METH_KEYWORDS, "Empty the document, keeping its buffer capacity."},
+    {"__enter__", (PyCFunction)Tron_enter, METH_NOARGS, NULL},
+    {"__exit__", (PyCFunction)Tron_exit, METH_FASTCALL, "Return a pooled Tron's buffer to its Pool."},
+    {"set_null", (PyCFunction)Tron_set_null_locked, METH_FASTCALL | METH_KEYWORDS, "Set null value in object."},
+    {"set_bool", (PyCFunction)Tron_set_bool_locked, METH_FASTCALL | METH_KEYWORDS, "Set boolean value in object."},
+    {"set_i64", (PyCFunction)Tron_set_i64_locked, METH_FASTCALL | METH_KEYWORDS, "Set int64 value in object."},
+    {"set_f64", (PyCFunction)Tron_set_f64_locked, METH_FASTCALL | METH_KEYWORDS, "Set float value in object."},
+    {"set_bytes", (PyCFunction)Tron_set_bytes_locked, METH_FASTCALL | METH_KEYWORDS, "Set bytes value in object."},
+    {"set_str", (PyCFunction)Tron_set_str_locked, METH_FASTCALL | METH_KEYWORDS, "Set string value in object."},
+    {"set_obj", (PyCFunction)Tron_set_obj_locked, METH_FASTCALL | METH_KEYWORDS, "Set nested object and return its offset."},
+    {"set_arr", (PyCFunction)Tron_set_arr_locked, METH_FASTCALL | METH_KEYWORDS, "Set nested array and return its offset."},
+    {"set_many", (PyCFunction)Tron_set_many_locked, METH_FASTCALL | METH_KEYWORDS, "Set many key/value pairs after growing the buffer once."},
+    {"delete", (PyCFunction)Tron_set_null_locked, METH_FASTCALL | METH_KEYWORDS, "Delete a key by setting null."},
+    {"get_bool", (PyCFunction)Tron_get_bool_locked, METH_FASTCALL | METH_KEYWORDS, "Get boolean value by key."},
+    {"get_i64", (PyCFunction)Tron_get_i64_locked, METH_FASTCALL | METH_KEYWORDS, "Get int64 value by key."},
+    {"get_f64", (PyCFunction)Tron_get_f64_locked, METH_FASTCALL | METH_KEYWORDS, "Get float value by key."},
+    {"get_bytes", (PyCFunction)Tron_get_bytes_locked, METH_FASTCALL | METH_KEYWORDS, "Get bytes value by key."},
+    {"get_str", (PyCFunction)Tron_get_str_locked, METH_FASTCALL | METH_KEYWORDS, "Get string value by key."},
+    {"get_obj", (PyCFunction)Tron_get_obj_locked, METH_FASTCALL | METH_KEYWORDS, "Get nested object offset by key."},
+    {"get_arr", (PyCFunction)Tron_get_arr_locked, METH_FASTCALL | METH_KEYWORDS, "Get nested array offset by key."},
+    {"get_type", (PyCFunction)Tron_get_type_locked, METH_FASTCALL | METH_KEYWORDS, "Get value type by key."},
+    {"get", (PyCFunction)Tron_get_locked, METH_FASTCALL | METH_KEYWORDS, "Get value by key and return a Python type."},
+    {"get_path", (PyCFunction)Tron_get_path_locked, METH_FASTCALL | METH_KEYWORDS, "Get a value by key/index path (str or tron.Path)."},
+    {"set_path", (PyCFunction)Tron_set_path_locked, METH_FASTCALL | METH_KEYWORDS, "Set a value by path, creating missing objects."},
+    {"get_many", (PyCFunction)Tron_get_many_locked, METH_FASTCALL | METH_KEYWORDS, "Get several keys in one call (tuple, or dict with as_dict=True)."},
+    {"extract", (PyCFunction)Tron_extract_locked, METH_FASTCALL | METH_KEYWORDS, "Get several paths in one call as a tuple."},
+    {"exists", (PyCFunction)Tron_exists_locked, METH_FASTCALL | METH_KEYWORDS, "Check if a key exists."},
+    {"arr_append_null", (PyCFunction)Tron_arr_append_null_locked, METH_FASTCALL | METH_KEYWORDS, "Append null to array."},
+    {"arr_append_bool", (PyCFunction)Tron_arr_append_bool_locked, METH_FASTCALL | METH_KEYWORDS, "Append boolean to array."},
+    {"arr_append_i64", (PyCFunction)Tron_arr_append_i64_locked, METH_FASTCALL | METH_KEYWORDS, "Append int64 to array."},
+    {"arr_append_f64", (PyCFunction)Tron_arr_append_f64_locked, METH_FASTCALL | METH_KEYWORDS, "Append float to array."},
+    {"arr_append_bytes", (PyCFunction)Tron_arr_append_bytes_locked, METH_FASTCALL | METH_KEYWORDS, "Append bytes to array."},
+    {"arr_append_str", (PyCFunction)Tron_arr_append_str_locked, METH_FASTCALL | METH_KEYWORDS, "Append string to array."},
+    {"arr_append_obj", (PyCFunction)Tron_arr_append_obj_locked, METH_FASTCALL | METH_KEYWORDS, "Append object to array and return its offset."},
+    {"arr_append_arr", (PyCFunction)Tron_arr_append_arr_locked, METH_FASTCALL | METH_KEYWORDS, "Append array to array and return its offset."},
+    {"arr_get_bool", (PyCFunction)Tron_arr_get_bool_locked, METH_FASTCALL | METH_KEYWORDS, "Get boolean from array by index."},
+    {"arr_get_i64", (PyCFunction)Tron_arr_get_i64_locked, METH_FASTCALL | METH_KEYWORDS, "Get int64 from array by index."},
+    {"arr_get_f64", (PyCFunction)Tron_arr_get_f64_locked, METH_FASTCALL | METH_KEYWORDS, "Get float from array by index."},
+    {"arr_get_bytes", (PyCFunction)Tron_arr_get_bytes_locked, METH_FASTCALL | METH_KEYWORDS, "Get bytes from array by index."},
+    {"arr_get_str", (PyCFunction)Tron_arr_get_str_locked, METH_FASTCALL | METH_KEYWORDS, "Get string from array by index."},
+    {"arr_get_obj", (PyCFunction)Tron_arr_get_obj_locked, METH_FASTCALL | METH_KEYWORDS, "Get object offset from array by index."},
+    {"arr_get_arr", (PyCFunction)Tron_arr_get_arr_locked, METH_FASTCALL | METH_KEYWORDS, "Get array offset from array by index."},
+    {"arr_extend_i64", (PyCFunction)Tron_arr_extend_i64_locked, METH_FASTCALL | METH_KEYWORDS, "Append every integer of a buffer (e.g. array('q')) to array."},
+    {"arr_extend_f64", (PyCFunction)Tron_arr_extend_f64_locked, METH_FASTCALL | METH_KEYWORDS, "Append every float of a buffer (e.g. array('d')) to array."},
+    {"arr_to_buffer", (PyCFunction)Tron_arr_to_buffer_locked, METH_FASTCALL | METH_KEYWORDS, "Copy a numeric array into an array.array or writable buffer."},
+    {"to_columns", (PyCFunction)Tron_to_columns_locked, METH_FASTCALL | METH_KEYWORDS, "Transpose an array of objects into per-field column buffers."},
+    {"extend_columns", (PyCFunction)Tron_extend_columns_locked, METH_FASTCALL | METH_KEYWORDS, "Append one object per row of a mapping of columns."},
+    {"select", (PyCFunction)Tron_select_locked, METH_FASTCALL | METH_KEYWORDS, "Filter an array of objects in C by a Predicate; indices, offsets or projected tuples."},
+    {"to_bytes", (PyCFunction)Tron_to_bytes_locked, METH_NOARGS, "Return raw buffer bytes."},
+    {"buflen", (PyCFunction)Tron_buflen_locked, METH_NOARGS, "Return used buffer length."},
+    {"bufsz", (PyCFunction)Tron_bufsz_locked, METH_NOARGS, "Return total buffer size."},
+    {"to_json", (PyCFunction)Tron_to_json_locked, METH_FASTCALL | METH_KEYWORDS, "Convert to JSON string."},
+    {"to_json_bytes", (PyCFunction)Tron_to_json_bytes_locked, METH_FASTCALL | METH_KEYWORDS, "Encode to UTF-8 JSON bytes."},
+    {"to_json_into", (PyCFunction)Tron_to_json_into_locked, METH_FASTCALL | METH_KEYWORDS, "Encode JSON into a writable buffer; returns bytes written."},
+    {"dump_json", (PyCFunction)Tron_dump_json_locked, METH_FASTCALL | METH_KEYWORDS, "Write JSON to a file object or fd in chunks; returns bytes written."},
+    {"keys", (PyCFunction)Tron_keys_locked, METH_FASTCALL | METH_KEYWORDS, "Iterate over the keys of an object."},
+    {"values", (PyCFunction)Tron_values_locked, METH_FASTCALL | METH_KEYWORDS, "Iterate over the values of an object or array."},
+    {"items", (PyCFunction)Tron_items_locked, METH_FASTCALL | METH_KEYWORDS, "Iterate over the (key, value) pairs of an object."},
+    {"count", (PyCFunction)Tron_count_locked, METH_FASTCALL | METH_KEYWORDS, "Number of entries in an object or array."},
+    {"to_obj", (PyCFunction)Tron_to_obj_locked, METH_FASTCALL | METH_KEYWORDS, "Convert to Python dict/list without a JSON round-trip."},
+    {"view", (PyCFunction)Tron_view_locked, METH_FASTCALL | METH_KEYWORDS, "Zero-copy TronDict/TronList view of an object or array."},
+    {"save", (PyCFunction)Tron_save_locked, METH_FASTCALL | METH_KEYWORDS, "Save raw buffer to file."},
+    {"freeze", (PyCFunction)Tron_freeze_locked, METH_NOARGS, "Read-only FrozenTron copy of this document."},
+    {"__reduce_ex__", (PyCFunction)Tron_reduce_ex_locked, METH_O, "Pickle support; protocol 5 pickles the buffer out of band."},
+    {"to_shared_memory", (PyCFunction)Tron_to_shared_memory_locked, METH_FASTCALL | METH_KEYWORDS, "Copy into a new multiprocessing SharedMemory segment."},
+    {"debug_fill", (PyCFunction)Tron_debug_fill_locked, METH_O, "Fill buffer with a byte value (testing)."},
+    {"from_bytes", (PyCFunction)Tron_from_bytes, METH_O | METH_CLASS, "Create Tron from raw bytes."},
+    {"from_columns", (PyCFunction)Tron_from_columns, METH_FASTCALL | METH_KEYWORDS | METH_CLASS,
+     "Create an array of objects from a mapping of columns."},
+    {"from_obj", (PyCFunction)Tron_from_obj, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, "Create Tron from a dict or list."},
+    {"from_json", (PyCFunction)Tron_from_json, METH_O | METH_CLASS, "Create Tron from a JSON str or UTF-8 bytes-like object."},
+    {"from_json_file", (PyCFunction)Tron_from_json_file, METH_O | METH_CLASS, "Create Tron from JSON file."},
+    {"from_file", (PyCFunction)Tron_from_file, METH_O | METH_CLASS, "Create Tron from raw buffer file."},
+    {"open_mmap", (PyCFunction)Tron_open_mmap, METH_FASTCALL | METH_KEYWORDS | METH_CLASS, "Memory-map a raw buffer file read-only."},
+    {"from_shared_memory", (PyCFunction)Tron_from_shared_memory, METH_FASTCALL | METH_KEYWORDS | METH_CLASS,
+     "Attach to a to_shared_memory() segment (zero-copy FrozenTron unless readonly=False; "
+     "no process may write the segment while it is attached)."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject TronType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.Tron",
+    .tp_basicsize = sizeof(TronObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "TRON (Lite3) context wrapper",
+    .tp_methods = Tron_methods,
+    .tp_as_buffer = &Tron_as_buffer,
+    .tp_as_mapping = &Tron_as_mapping,
+    .tp_as_sequence = &Tron_as_sequence,
+    .tp_iter = (getiterfunc)Tron_iter_locked,
+    .tp_init = (initproc)Tron_init,
+    .tp_new = PyType_GenericNew,
+    .tp_vectorcall = Tron_vectorcall,
+    .tp_dealloc = (destructor)Tron_dealloc,
+};
+
+/* 64-bit multiply-xorshift over 8-byte words with a splitmix64 finish; FrozenTron
+ * buffers never change, so the result is computed once and cached. */
+static Py_hash_t tron_hash_buffer(const unsigned char *buf, size_t len)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t)len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, buf + i, sizeof(word));
+        h = (h ^ word) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+    for (; i < len; i++) {
+        h = (h ^ buf[i]) * 0x100000001b3ULL;
+    }
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+
+    Py_hash_t hash = (Py_hash_t)h;
+    return hash == -1 || hash == 0 ? 1 : hash;
+}
+
+/* Racing threads may both compute the hash; they store the same value, so relaxed
+ * atomics are enough to keep the cache free of torn reads. */
+static Py_hash_t FrozenTron_hash(TronObject *self)
+{
+    Py_hash_t hash = TRON_ATOMIC_LOAD_SSIZE_RELAXED(self->hash);
+    if (!hash) {
+        hash = tron_hash_buffer(self->ctx->buf, self->ctx->buflen);
+        TRON_ATOMIC_STORE_SSIZE_RELAXED(self->hash, hash);
+    }
+    return hash;
+}
+
+/* Byte-wise: equal documents built in a different order do not compare equal. */
+static PyObject *FrozenTron_richcompare(PyObject *self, PyObject *other, int op)
+{
+    if ((op != Py_EQ && op != Py_NE) || !Py_IS_TYPE(other, &FrozenTronType)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    Py_hash_t ha = TRON_ATOMIC_LOAD_SSIZE_RELAXED(((TronObject *)self)->hash);
+    Py_hash_t hb = TRON_ATOMIC_LOAD_SSIZE_RELAXED(((TronObject *)other)->hash);
+    const lite3_ctx *a = ((TronObject *)self)->ctx;
+    const lite3_ctx *b = ((TronObject *)other)->ctx;
+    bool equal = self == other ||
+                 (a->buflen == b->buflen && (!ha || !hb || ha == hb) &&
+                  memcmp(a->buf, b->buf, a->buflen) == 0);
+    return PyBool_FromLong(equal == (op == Py_EQ));
+}
+
+/* Zero-copy: the FrozenTron keeps the exporter's buffer pinned for its lifetime, so an
+ * mmap-backed record costs one small allocation and no copy. */
+static PyObject *FrozenTron_from_buffer(PyTypeObject *type, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "from_buffer", 1, "buffer", "offset", "length");
+    PyObject *argv[3];
+    Py_ssize_t offset = 0;
+    Py_ssize_t length = -1;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_ssize(argv[1], &offset) < 0 || tron_arg_ssize(argv[2], &length) < 0) {
+        return NULL;
+    }
+
+    Py_buffer view;
+    if (PyObject_GetBuffer(argv[0], &view, PyBUF_SIMPLE) < 0) {
+        return NULL;
+    }
+    return tron_frozen_from_view(&view, offset, length, false);
+}
+
+static PyMethodDef FrozenTron_methods[] = {
+    {"from_buffer", (PyCFunction)FrozenTron_from_buffer, METH_FASTCALL | METH_KEYWORDS | METH_CLASS,
+     "Zero-copy FrozenTron over read-only buffer[offset:offset+length] (e.g. an mmap); writable buffers are copied."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject FrozenTronType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.FrozenTron",
+    .tp_basicsize = sizeof(TronObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Read-only Tron: lock-free reads from any thread, hashable, byte-wise ==",
+    .tp_base = &TronType,
+    .tp_hash = (hashfunc)FrozenTron_hash,
+    .tp_richcompare = FrozenTron_richcompare,
+    .tp_methods = FrozenTron_methods,
+    .tp_vectorcall = Tron_vectorcall,
+};
+
+/* Free list of idle contexts: acquire() pops one (or creates one of bufsz) and the
+ * Tron's release/__exit__/dealloc pushes it back, up to max_idle. */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t bufsz;
+    Py_ssize_t max_idle;
+    Py_ssize_t idle;
+    lite3_ctx **free_list;
+    PyMutex mutex;
+} PoolObject;
+
+/* A ctx that grew past this multiple of the pool's bufsz is freed rather than kept idle. */
+#define TRON_POOL_MAX_GROWTH 8
+
+static void tron_pool_put(PyObject *pool_obj, lite3_ctx *ctx)
+{
+    PoolObject *pool = (PoolObject *)pool_obj;
+    PyMutex_Lock(&pool->mutex);
+    if (pool->idle < pool->max_idle && ctx->bufsz <= (size_t)pool->bufsz * TRON_POOL_MAX_GROWTH) {
+        pool->free_list[pool->idle++] = ctx;
+        ctx = NULL;
+    }
+    PyMutex_Unlock(&pool->mutex);
+    if (ctx) {
+        lite3_ctx_destroy(ctx);
+    }
+}
+
+static PyObject *Pool_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    Py_ssize_t bufsz = LITE3_CONTEXT_BUF_SIZE_MIN;
+    Py_ssize_t max_idle = 64;
+    static char *kwlist[] = {"bufsz", "max_idle", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|nn", kwlist, &bufsz, &max_idle)) {
+        return NULL;
+    }
+    if (bufsz <= 0 || max_idle < 0) {
+        PyErr_SetString(PyExc_ValueError, "bufsz must be positive and max_idle non-negative");
+        return NULL;
+    }
+
+    PoolObject *self = (PoolObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+    self->bufsz = bufsz;
+    self->max_idle = max_idle;
+    self->free_list = (lite3_ctx **)PyMem_Calloc(max_idle ? (size_t)max_idle : 1, sizeof(lite3_ctx *));
+    if (!self->free_list) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)self;
+}
+
+static void Pool_dealloc(PoolObject *self)
+{
+    for (Py_ssize_t i = 0; i < self->idle; i++) {
+        lite3_ctx_destroy(self->free_list[i]);
+    }
+    PyMem_Free(self->free_list);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *Pool_acquire(PoolObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "acquire", 0, "root");
+    PyObject *argv[1];
+    const char *root = "object";
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+    if (tron_arg_cstr(argv[0], &root) < 0) {
+        return NULL;
+    }
+    bool is_obj = strcmp(root, "object") == 0;
+    if (!is_obj && strcmp(root, "array") != 0) {
+        PyErr_SetString(PyExc_ValueError, "root must be 'object' or 'array'");
+        return NULL;
+    }
+
+    lite3_ctx *ctx = NULL;
+    PyMutex_Lock(&self->mutex);
+    if (self->idle > 0) {
+        ctx = self->free_list[--self->idle];
+    }
+    PyMutex_Unlock(&self->mutex);
+    if (!ctx) {
+        ctx = lite3_ctx_create_with_size((size_t)self->bufsz);
+        if (!ctx) {
+            return tron_raise_errno("lite3_ctx_create_with_size");
+        }
+    }
+
+    if ((is_obj ? lite3_ctx_init_obj(ctx) : lite3_ctx_init_arr(ctx)) < 0) {
+        tron_raise_errno("lite3_ctx_init");
+        lite3_ctx_destroy(ctx);
+        return NULL;
+    }
+
+    TronObject *tron = tron_create_with_ctx(&TronType, ctx);
+    if (!tron) {
+        tron_pool_put((PyObject *)self, ctx);
+        return NULL;
+    }
+    tron->pool = Py_NewRef(self);
+    return (PyObject *)tron;
+}
+
+static PyObject *Pool_release(PoolObject *self, PyObject *arg)
+{
+    if (!Py_IS_TYPE(arg, &TronType)) {
+        PyErr_Format(PyExc_TypeError, "expected a Tron, got %.200s", Py_TYPE(arg)->tp_name);
+        return NULL;
+    }
+    TronObject *tron = (TronObject *)arg;
+
+    /* pool and ctx are only stable inside the Tron's critical section. */
+    int ret = 0;
+    Py_BEGIN_CRITICAL_SECTION(tron);
+    if (tron->pool != (PyObject *)self && tron->ctx) {
+        PyErr_SetString(PyExc_ValueError, "Tron was not acquired from this pool");
+        ret = -1;
+    } else {
+        ret = tron_pool_release(tron);
+    }
+    Py_END_CRITICAL_SECTION();
+    if (ret < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Pool_get_idle(PoolObject *self, void *Py_UNUSED(closure))
+{
+    PyMutex_Lock(&self->mutex);
+    Py_ssize_t idle = self->idle;
+    PyMutex_Unlock(&self->mutex);
+    return PyLong_FromSsize_t(idle);
+}
+
+static PyMemberDef Pool_members[] = {
+    {"bufsz", Py_T_PYSSIZET, offsetof(PoolObject, bufsz), Py_READONLY, "Initial buffer size of new contexts."},
+    {"max_idle", Py_T_PYSSIZET, offsetof(PoolObject, max_idle), Py_READONLY, "Most idle contexts kept."},
+    {NULL}
+};
+
+static PyGetSetDef Pool_getset[] = {
+    {"idle", (getter)Pool_get_idle, NULL, "Number of idle contexts ready for reuse.", NULL},
+    {NULL}
+};
+
+static PyMethodDef Pool_methods[] = {
+    {"acquire", (PyCFunction)Pool_acquire, METH_FASTCALL | METH_KEYWORDS, "Tron backed by a pooled buffer."},
+    {"release", (PyCFunction)Pool_release, METH_O, "Return a Tron's buffer to the pool."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject PoolType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.Pool",
+    .tp_basicsize = sizeof(PoolObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Pool(bufsz=LITE3_CONTEXT_BUF_SIZE_MIN, max_idle=64): reuses Tron buffers",
+    .tp_methods = Pool_methods,
+    .tp_members = Pool_members,
+    .tp_getset = Pool_getset,
+    .tp_new = Pool_new,
+    .tp_dealloc = (destructor)Pool_dealloc,
+};
+
+static PyObject *Key_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *name = NULL;
+    static char *kwlist[] = {"name", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "U", kwlist, &name)) {
+        return NULL;
+    }
+
+    const char *key = tron_key_from_py(name);
+    if (!key) {
+        return NULL;
+    }
+
+    KeyObject *self = (KeyObject *)type->tp_alloc(type, 0);
+    if (!self) {
+        return NULL;
+    }
+
+    /* key points into name's cached UTF-8, which lives as long as we hold name. */
+    self->name = Py_NewRef(name);
+    self->key.key = key;
+    self->key.key_data = lite3_get_key_data(key);
+    return (PyObject *)self;
+}
+
+static void Key_dealloc(KeyObject *self)
+{
+    Py_XDECREF(self->name);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *Key_repr(KeyObject *self)
+{
+    return PyUnicode_FromFormat("Key(%R)", self->name);
+}
+
+static PyObject *Key_str(KeyObject *self)
+{
+    return Py_NewRef(self->name);
+}
+
+static PyMemberDef Key_members[] = {
+    {"name", Py_T_OBJECT_EX, offsetof(KeyObject, name), Py_READONLY, "Key string."},
+    {"hash", Py_T_UINT, offsetof(KeyObject, key.key_data.hash), Py_READONLY, "Precomputed DJB2 hash."},
+    {NULL}
+};
+
+static PyTypeObject KeyType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.Key",
+    .tp_basicsize = sizeof(KeyObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Object key with its hash precomputed, accepted wherever a str key is",
+    .tp_members = Key_members,
+    .tp_new = Key_new,
+    .tp_dealloc = (destructor)Key_dealloc,
+    .tp_repr = (reprfunc)Key_repr,
+    .tp_str = (reprfunc)Key_str,
+};
+
+static PyObject *Path_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *spec = NULL;
+    static char *kwlist[] = {"spec", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwlist, &spec)) {
+        return NULL;
+    }
+
+    return tron_path_compile(type, spec);
+}
+
+static void Path_dealloc(PathObject *self)
+{
+    Py_XDECREF(self->source);
+    PyMem_Free(self->keybuf);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject *Path_repr(PathObject *self)
+{
+    return PyUnicode_FromFormat("Path(%R)", self->source);
+}
+
+static PyObject *Path_get_segments(PathObject *self, void *Py_UNUSED(closure))
+{
+    PyObject *segments = PyTuple_New(Py_SIZE(self));
+    if (!segments) {
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < Py_SIZE(self); i++) {
+        const tron_path_seg *seg = &self->segs[i];
+        PyObject *item = seg->key.key ? PyUnicode_FromString(seg->key.key) : PyLong_FromUnsignedLong(seg->index);
+        if (!item) {
+            Py_DECREF(segments);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(segments, i, item);
+    }
+
+    return segments;
+}
+
+static PyGetSetDef Path_getset[] = {
+    {"segments", (getter)Path_get_segments, NULL, "Keys (str) and array indexes (int), in order.", NULL},
+    {NULL}
+};
+
+static PyTypeObject PathType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.Path",
+    .tp_basicsize = offsetof(PathObject, segs),
+    .tp_itemsize = sizeof(tron_path_seg),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Compiled key/index path such as \"a.b[3].c\", resolved in one call",
+    .tp_getset = Path_getset,
+    .tp_new = Path_new,
+    .tp_dealloc = (destructor)Path_dealloc,
+    .tp_repr = (reprfunc)Path_repr,
+};
+
+/* Upper bound on and/or/not nesting, so compiling and evaluating never recurse deeply. */
+#define TRON_PRED_MAX_DEPTH 32
+
+typedef struct {
+    tron_pred_node *nodes;
+    Py_ssize_t count;
+    Py_ssize_t cap;
+    PyObject *refs;
+} tron_pred_builder;
+
+static Py_ssize_t tron_pred_compile(tron_pred_builder *b, PyObject *spec, int depth);
+
+/* Compiles one node of spec from items, a snapshot of its n entries. */
+static Py_ssize_t tron_pred_compile_node(tron_pred_builder *b, PyObject *spec, PyObject *const *items,
+                                         Py_ssize_t n, int depth)
+{
+    const char *name = n > 0 && PyUnicode_Check(items[0]) ? PyUnicode_AsUTF8(items[0]) : NULL;
+    int op = -1;
+    for (int i = 0; name && i < (int)(sizeof(tron_pred_op_names) / sizeof(tron_pred_op_names[0])); i++) {
+        if (strcmp(name, tron_pred_op_names[i]) == 0) {
+            op = i;
+        }
+    }
+    if (op < 0) {
+        if (!PyErr_Occurred()) {
+            PyErr_Format(PyExc_ValueError, "unknown predicate operator in %R", spec);
+        }
+        return -1;
+    }
+
+    if (b->count == b->cap) {
+        Py_ssize_t cap = b->cap ? b->cap * 2 : 8;
+        tron_pred_node *grown = PyMem_Realloc(b->nodes, (size_t)cap * sizeof(tron_pred_node));
+        if (!grown) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        b->nodes = grown;
+        b->cap = cap;
+    }
+    Py_ssize_t index = b->count++;
+    tron_pred_node node = {.op = (uint8_t)op};
+
+    if (op <= TRON_PRED_NOT) {
+        if (n < 2 || (op == TRON_PRED_NOT && n != 2)) {
+            PyErr_Format(PyExc_ValueError, "%R needs %s operand", spec, op == TRON_PRED_NOT ? "exactly one" : "at least one");
+            return -1;
+        }
+        for (Py_ssize_t i = 1; i < n; i++) {
+            if (tron_pred_compile(b, items[i], depth + 1) < 0) {
+                return -1;
+            }
+        }
+    } else {
+        if (n != 3) {
+            PyErr_Format(PyExc_ValueError, "comparison %R must be (op, path, value)", spec);
+            return -1;
+        }
+        PathObject *path = tron_path_from_arg(items[1]);
+        if (!path) {
+            return -1;
+        }
+        int added = PyList_Append(b->refs, (PyObject *)path);
+        node.field = path;
+        Py_DECREF(path);
+        if (added < 0) {
+            return -1;
+        }
+
+        PyObject *value = items[2];
+        if (value == Py_None || PyBool_Check(value)) {
+            if (op != TRON_PRED_EQ && op != TRON_PRED_NE) {
+                PyErr_Format(PyExc_ValueError, "%R: None and bool only support == and !=", spec);
+                return -1;
+            }
+            node.kind = value == Py_None ? TRON_PRED_NULL : TRON_PRED_BOOL;
+            node.value.b = value == Py_True;
+        } else if (PyLong_Check(value)) {
+            node.kind = TRON_PRED_I64;
+            node.value.i64 = PyLong_AsLongLong(value);
+            if (node.value.i64 == -1 && PyErr_Occurred()) {
+                return -1;
+            }
+        } else if (PyFloat_Check(value)) {
+            node.kind = TRON_PRED_F64;
+            node.value.f64 = PyFloat_AS_DOUBLE(value);
+        } else if (PyUnicode_Check(value)) {
+            Py_ssize_t len = 0;
+            node.kind = TRON_PRED_STR;
+            node.value.str.ptr = PyUnicode_AsUTF8AndSize(value, &len);
+            node.value.str.len = (size_t)len;
+            if (!node.value.str.ptr || PyList_Append(b->refs, value) < 0) {
+                return -1;
+            }
+        } else {
+            PyErr_Format(PyExc_TypeError, "%R: value must be None, bool, int, float or str", spec);
+            return -1;
+        }
+    }
+
+    node.size = (uint32_t)(b->count - index);
+    b->nodes[index] = node;
+    return index;
+}
+
+/* Appends spec in prefix order and returns its node index, or -1. */
+static Py_ssize_t tron_pred_compile(tron_pred_builder *b, PyObject *spec, int depth)
+{
+    if (depth > TRON_PRED_MAX_DEPTH) {
+        PyErr_SetString(PyExc_ValueError, "predicate nested too deeply");
+        return -1;
+    }
+    if (!PyTuple_Check(spec) && !PyList_Check(spec)) {
+        PyErr_Format(PyExc_TypeError, "predicate must be a tuple like ('>', 'score', 0.9), not %.200s",
+                     Py_TYPE(spec)->tp_name);
+        return -1;
+    }
+
+    /* Compiling runs Python code (str and Path conversion), so a list spec is copied first. */
+    PyObject *items = PySequence_Tuple(spec);
+    if (!items) {
+        return -1;
+    }
+    Py_ssize_t index = tron_pred_compile_node(b, spec, PySequence_Fast_ITEMS(items), PyTuple_GET_SIZE(items), depth);
+    Py_DECREF(items);
+    return index;
+}
+
+static PyObject *Predicate_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *spec = NULL;
+    static char *kwlist[] = {"spec", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O:Predicate", kwlist, &spec)) {
+        return NULL;
+    }
+    if (Py_IS_TYPE(spec, &PredicateType)) {
+        return Py_NewRef(spec);
+    }
+
+    PredicateObject *self = NULL;
+    tron_pred_builder b = {.refs = PyList_New(0)};
+    if (b.refs && tron_pred_compile(&b, spec, 0) >= 0) {
+        self = PyObject_GC_NewVar(PredicateObject, type, b.count);
+        if (self) {
+            memcpy(self->nodes, b.nodes, (size_t)b.count * sizeof(tron_pred_node));
+            self->spec = Py_NewRef(spec);
+            self->refs = Py_NewRef(b.refs);
+            PyObject_GC_Track(self);
+        }
+    }
+    PyMem_Free(b.nodes);
+    Py_XDECREF(b.refs);
+    return (PyObject *)self;
+}
+
+/* spec and the paths in refs may hold arbitrary objects, so a cycle can run through them. */
+static int Predicate_traverse(PredicateObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(self->spec);
+    Py_VISIT(self->refs);
+    return 0;
+}
+
+/* Leaves the nodes dangling; select() checks refs before it evaluates them. */
+static int Predicate_clear(PredicateObject *self)
+{
+    Py_CLEAR(self->spec);
+    Py_CLEAR(self->refs);
+    return 0;
+}
+
+static void Predicate_dealloc(PredicateObject *self)
+{
+    PyObject_GC_UnTrack(self);
+    Predicate_clear(self);
+    PyObject_GC_Del(self);
+}
+
+static PyObject *Predicate_repr(PredicateObject *self)
+{
+    return PyUnicode_FromFormat("Predicate(%R)", self->spec);
+}
+
+static PyMemberDef Predicate_members[] = {
+    {"spec", Py_T_OBJECT_EX, offsetof(PredicateObject, spec), Py_READONLY, "The tuple this predicate was compiled from."},
+    {NULL}
+};
+
+static PyTypeObject PredicateType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.Predicate",
+    .tp_basicsize = offsetof(PredicateObject, nodes),
+    .tp_itemsize = sizeof(tron_pred_node),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_doc = "Compiled select() filter, e.g. ('and', ('==', 'status', 'active'), ('>', 'score', 0.9))",
+    .tp_traverse = (traverseproc)Predicate_traverse,
+    .tp_clear = (inquiry)Predicate_clear,
+    .tp_members = Predicate_members,
+    .tp_new = Predicate_new,
+    .tp_dealloc = (destructor)Predicate_dealloc,
+    .tp_repr = (reprfunc)Predicate_repr,
+};
+
+static void TronIter_dealloc(TronIterObject *self)
+{
+    Py_XDECREF(self->tron);
+    PyObject_Free(self);
+}
+
+static PyObject *TronIter_next(TronIterObject *self)
+{
+    if (self->done) {
+        return NULL;
+    }
+    if (self->version != self->tron->version) {
+        self->done = true;
+        PyErr_SetString(PyExc_RuntimeError, "Tron changed during iteration");
+        return NULL;
+    }
+
+    const lite3_ctx *ctx = self->tron->ctx;
+    lite3_str key;
+    size_t val_ofs = 0;
+    int ret = lite3_iter_next(ctx->buf, ctx->buflen, &self->iter,
+                              self->kind == TRON_ITER_VALUES ? NULL : &key, &val_ofs);
+    if (ret != LITE3_ITER_ITEM) {
+        self->done = true;
+        return ret < 0 ? tron_raise_errno("lite3_iter_next") : NULL;
+    }
+
+    PyObject *key_obj = NULL;
+    if (self->kind != TRON_ITER_VALUES) {
+        const char *key_str = LITE3_STR(ctx->buf, key);
+        if (!key_str) {
+            PyErr_SetString(TronError, "stale string reference");
+            return NULL;
+        }
+        key_obj = PyUnicode_FromStringAndSize(key_str, (Py_ssize_t)key.len);
+        if (!key_obj || self->kind == TRON_ITER_KEYS) {
+            return key_obj;
+        }
+    }
+
+    const lite3_val *val = (const lite3_val *)(ctx->buf + val_ofs);
+    PyObject *value = self->views ? tron_val_to_view(self->tron, val) : tron_val_to_py(ctx, val);
+    if (!value || !key_obj) {
+        Py_XDECREF(key_obj);
+        return value;
+    }
+
+    PyObject *pair = PyTuple_Pack(2, key_obj, value);
+    Py_DECREF(key_obj);
+    Py_DECREF(value);
+    return pair;
+}
+
+/* Not TRON_LOCKED: the cursor in self is mutable even when the Tron is frozen, so the
+ * iterator is always locked, together with a Tron that can change. */
+static PyObject *TronIter_next_locked(TronIterObject *self)
+{
+    PyObject *result = NULL;
+    TronObject *tron = self->tron;
+    if (tron_is_frozen(tron)) {
+        Py_BEGIN_CRITICAL_SECTION(self);
+        result = TronIter_next(self);
+        Py_END_CRITICAL_SECTION();
+        return result;
+    }
+    Py_BEGIN_CRITICAL_SECTION2(self, tron);
+    if (tron->ctx) {
+        Py_ssize_t depth = tron_lock_held(tron);
+        result = TronIter_next(self);
+        tron_unlock_to(tron, depth);
+    } else {
+        tron_raise_released();
+    }
+    Py_END_CRITICAL_SECTION2();
+    return result;
+}
+
+static PyTypeObject TronIterType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.TronIterator",
+    .tp_basicsize = sizeof(TronIterObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Lazy iterator over the keys, values or items of a Tron object/array",
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)TronIter_next_locked,
+    .tp_dealloc = (destructor)TronIter_dealloc,
+};
+
+static void TronView_dealloc(TronViewObject *self)
+{
+    Py_XDECREF(self->tron);
+    PyObject_Free(self);
+}
+
+static int tron_view_check(const TronViewObject *self)
+{
+    if (self->version != self->tron->version) {
+        PyErr_SetString(PyExc_RuntimeError, "Tron changed since this view was created");
+        return -1;
+    }
+    return 0;
+}
+
+static Py_ssize_t TronView_length(TronViewObject *self)
+{
+    if (tron_view_check(self) < 0) {
+        return -1;
+    }
+    uint32_t count = 0;
+    if (lite3_count(self->tron->ctx->buf, self->tron->ctx->buflen, self->ofs, &count) < 0) {
+        tron_raise_errno("lite3_count");
+        return -1;
+    }
+    return (Py_ssize_t)count;
+}
+
+static PyObject *TronView_to_obj(TronViewObject *self, PyObject *Py_UNUSED(ignored))
+{
+    if (tron_view_check(self) < 0) {
+        return NULL;
+    }
+    return tron_node_to_obj(self->tron->ctx->buf, self->tron->ctx->buflen, self->ofs);
+}
+
+TRON_LOCKED(Py_ssize_t, -1, TronView_length, self->tron, (TronViewObject *self), (self))
+TRON_LOCKED(PyObject *, NULL, TronView_to_obj, self->tron, (TronViewObject *self, PyObject *ignored), (self, ignored))
+
+static bool tron_is_view(PyObject *obj)
+{
+    return Py_IS_TYPE(obj, &TronDictType) || Py_IS_TYPE(obj, &TronListType);
+}
+
+/* Equality materializes both sides; views are for reading a few fields, not comparing. */
+static PyObject *TronView_richcompare(PyObject *self, PyObject *other, int op)
+{
+    if (op != Py_EQ && op != Py_NE) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+
+    PyObject *left = TronView_to_obj_locked((TronViewObject *)self, NULL);
+    if (!left) {
+        return NULL;
+    }
+    PyObject *right = tron_is_view(other) ? TronView_to_obj_locked((TronViewObject *)other, NULL) : Py_NewRef(other);
+    if (!right) {
+        Py_DECREF(left);
+        return NULL;
+    }
+
+    PyObject *result = PyObject_RichCompare(left, right, op);
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return result;
+}
+
+static PyObject *TronView_repr(TronViewObject *self)
+{
+    PyObject *obj = TronView_to_obj_locked(self, NULL);
+    if (!obj) {
+        return NULL;
+    }
+    PyObject *name = PyType_GetName(Py_TYPE(self));
+    PyObject *repr = name ? PyUnicode_FromFormat("%U(%R)", name, obj) : NULL;
+    Py_XDECREF(name);
+    Py_DECREF(obj);
+    return repr;
+}
+
+static PyObject *TronView_get_ofs(TronViewObject *self, void *Py_UNUSED(closure))
+{
+    return PyLong_FromSize_t(self->ofs);
+}
+
+static PyObject *TronView_get_tron(TronViewObject *self, void *Py_UNUSED(closure))
+{
+    return Py_NewRef(self->tron);
+}
+
+static PyGetSetDef TronView_getset[] = {
+    {"ofs", (getter)TronView_get_ofs, NULL, "Offset of the viewed object/array.", NULL},
+    {"tron", (getter)TronView_get_tron, NULL, "The Tron holding the buffer.", NULL},
+    {NULL}
+};
+
+/* 1 found, 0 absent, -1 error. */
+static int tron_dict_lookup(TronViewObject *self, PyObject *key_obj, lite3_val **val)
+{
+    tron_key key;
+    if (tron_view_check(self) < 0 || tron_arg_key(key_obj, &key) < 0) {
+        return -1;
+    }
+    errno = 0;
+    if (tron_ctx_get(self->tron->ctx, self->ofs, &key, val) == 0) {
+        return 1;
+    }
+    if (errno == ENOENT) {
+        return 0;
+    }
+    tron_raise_errno("lite3_get_impl");
+    return -1;
+}
+
+static PyObject *TronDict_subscript(TronViewObject *self, PyObject *key_obj)
+{
+    lite3_val *val = NULL;
+    int found = tron_dict_lookup(self, key_obj, &val);
+    if (found < 0) {
+        return NULL;
+    }
+    if (!found) {
+        PyErr_SetObject(PyExc_KeyError, key_obj);
+        return NULL;
+    }
+    return tron_val_to_view(self->tron, val);
+}
+
+static int TronDict_contains(TronViewObject *self, PyObject *key_obj)
+{
+    if (!PyUnicode_Check(key_obj) && !Py_IS_TYPE(key_obj, &KeyType)) {
+        return 0;
+    }
+    lite3_val *val = NULL;
+    return tron_dict_lookup(self, key_obj, &val);
+}
+
+static PyObject *TronDict_iter(TronViewObject *self)
+{
+    if (tron_view_check(self) < 0) {
+        return NULL;
+    }
+    return tron_iter_new(self->tron, self->ofs, TRON_ITER_KEYS, true);
+}
+
+static PyObject *TronDict_get(TronViewObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "get", 1, "key", "default");
+    PyObject *argv[2];
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    int found = tron_dict_lookup(self, argv[0], &val);
+    if (found < 0) {
+        return NULL;
+    }
+    if (!found) {
+        return Py_NewRef(argv[1] ? argv[1] : Py_None);
+    }
+    return tron_val_to_view(self->tron, val);
+}
+
+static PyObject *TronDict_keys(TronViewObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return PyObject_CallOneArg(AbcKeysView, (PyObject *)self);
 }
 
-static PyObject *Tron_to_bytes(TronObject *self, PyObject *Py_UNUSED(args))
+static PyObject *TronDict_values(TronViewObject *self, PyObject *Py_UNUSED(ignored))
 {
-    return PyBytes_FromStringAndSize((const char *)self->ctx->buf, (Py_ssize_t)self->ctx->buflen);
+    return PyObject_CallOneArg(AbcValuesView, (PyObject *)self);
 }
 
-static PyObject *Tron_buflen(TronObject *self, PyObject *Py_UNUSED(args))
+static PyObject *TronDict_items(TronViewObject *self, PyObject *Py_UNUSED(ignored))
 {
-    return PyLong_FromSize_t(self->ctx->buflen);
+    return PyObject_CallOneArg(AbcItemsView, (PyObject *)self);
 }
 
-static PyObject *Tron_bufsz(TronObject *self, PyObject *Py_UNUSED(args))
+TRON_LOCKED(PyObject *, NULL, TronDict_subscript, self->tron, (TronViewObject *self, PyObject *key_obj), (self, key_obj))
+TRON_LOCKED(int, -1, TronDict_contains, self->tron, (TronViewObject *self, PyObject *key_obj), (self, key_obj))
+TRON_LOCKED(PyObject *, NULL, TronDict_iter, self->tron, (TronViewObject *self), (self))
+TRON_LOCKED(PyObject *, NULL, TronDict_get, self->tron,
+            (TronViewObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames),
+            (self, args, nargs, kwnames))
+
+static PyMappingMethods TronDict_as_mapping = {
+    .mp_length = (lenfunc)TronView_length_locked,
+    .mp_subscript = (binaryfunc)TronDict_subscript_locked,
+};
+
+static PySequenceMethods TronDict_as_sequence = {
+    .sq_contains = (objobjproc)TronDict_contains_locked,
+};
+
+static PyMethodDef TronDict_methods[] = {
+    {"get", (PyCFunction)TronDict_get_locked, METH_FASTCALL | METH_KEYWORDS, "Value for key, or default when absent."},
+    {"keys", (PyCFunction)TronDict_keys, METH_NOARGS, "KeysView over the object."},
+    {"values", (PyCFunction)TronDict_values, METH_NOARGS, "ValuesView over the object."},
+    {"items", (PyCFunction)TronDict_items, METH_NOARGS, "ItemsView over the object."},
+    {"to_obj", (PyCFunction)TronView_to_obj_locked, METH_NOARGS, "Materialize the object as a dict."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject TronDictType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.TronDict",
+    .tp_basicsize = sizeof(TronViewObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_MAPPING,
+    .tp_doc = "Read-only Mapping view of a Tron object; nested containers are views too",
+    .tp_methods = TronDict_methods,
+    .tp_getset = TronView_getset,
+    .tp_as_mapping = &TronDict_as_mapping,
+    .tp_as_sequence = &TronDict_as_sequence,
+    .tp_iter = (getiterfunc)TronDict_iter_locked,
+    .tp_richcompare = TronView_richcompare,
+    .tp_hash = PyObject_HashNotImplemented,
+    .tp_repr = (reprfunc)TronView_repr,
+    .tp_dealloc = (destructor)TronView_dealloc,
+};
+
+static PyObject *TronList_item(TronViewObject *self, Py_ssize_t index)
 {
-    return PyLong_FromSize_t(self->ctx->bufsz);
+    Py_ssize_t count = TronView_length(self);
+    if (count < 0) {
+        return NULL;
+    }
+    if (index < 0 || index >= count) {
+        PyErr_SetString(PyExc_IndexError, "TronList index out of range");
+        return NULL;
+    }
+
+    lite3_val *val = NULL;
+    if (tron_ctx_arr_get(self->tron->ctx, self->ofs, (uint32_t)index, &val) < 0) {
+        return tron_raise_errno("lite3_arr_get");
+    }
+    return tron_val_to_view(self->tron, val);
 }
 
-static PyObject *Tron_to_json(TronObject *self, PyObject *args, PyObject *kwargs)
+static PyObject *TronList_subscript(TronViewObject *self, PyObject *item)
 {
-    Py_ssize_t ofs = 0;
-    int pretty = 0;
-    static char *kwlist[] = {"ofs", "pretty", NULL};
+    if (PyIndex_Check(item)) {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (index < 0) {
+            Py_ssize_t count = TronView_length(self);
+            if (count < 0) {
+                return NULL;
+            }
+            index += count;
+        }
+        return TronList_item(self, index);
+    }
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|np", kwlist, &ofs, &pretty)) {
+    if (!PySlice_Check(item)) {
+        PyErr_Format(PyExc_TypeError, "TronList indices must be integers or slices, not %.200s",
+                     Py_TYPE(item)->tp_name);
         return NULL;
     }
 
-    size_t out_len = 0;
-    char *json = NULL;
-    if (pretty) {
-        json = lite3_ctx_json_enc_pretty(self->ctx, (size_t)ofs, &out_len);
-    } else {
-        json = lite3_ctx_json_enc(self->ctx, (size_t)ofs, &out_len);
+    Py_ssize_t start, stop, step;
+    if (PySlice_Unpack(item, &start, &stop, &step) < 0) {
+        return NULL;
     }
-
-    if (!json) {
-        return tron_raise_errno("lite3_ctx_json_enc");
+    Py_ssize_t count = TronView_length(self);
+    if (count < 0) {
+        return NULL;
     }
+    Py_ssize_t slice_len = PySlice_AdjustIndices(count, &start, &stop, step);
 
-    PyObject *result = PyUnicode_FromStringAndSize(json, (Py_ssize_t)out_len);
-    free(json);
+    PyObject *result = PyList_New(slice_len);
+    if (!result) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0, index = start; i < slice_len; i++, index += step) {
+        PyObject *value = TronList_item(self, index);
+        if (!value) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, value);
+    }
     return result;
 }
 
-static PyObject *Tron_save(TronObject *self, PyObject *args, PyObject *kwargs)
+/* Linear scan for value over [start, stop): returns the first index (find) or the number
+ * of matches (!find), -1 with an exception set on error, -2 when find fails. */
+static Py_ssize_t tron_list_scan(TronViewObject *self, PyObject *value, Py_ssize_t start, Py_ssize_t stop, bool find)
 {
-    const char *path = NULL;
-    static char *kwlist[] = {"path", NULL};
+    Py_ssize_t matches = 0;
+    uint64_t version = self->tron->version;
+    lite3_iter iter;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", kwlist, &path)) {
-        return NULL;
+    if (tron_view_check(self) < 0) {
+        return -1;
     }
-
-    FILE *fp = fopen(path, "wb");
-    if (!fp) {
-        return tron_raise_errno("fopen");
+    if (lite3_iter_create(self->tron->ctx->buf, self->tron->ctx->buflen, self->ofs, &iter) < 0) {
+        tron_raise_errno("lite3_iter_create");
+        return -1;
     }
 
-    size_t written = fwrite(self->ctx->buf, 1, self->ctx->buflen, fp);
-    int saved_errno = errno;
-    fclose(fp);
+    size_t val_ofs = 0;
+    int ret;
+    for (Py_ssize_t index = 0; index < stop; index++) {
+        const lite3_ctx *ctx = self->tron->ctx;
+        ret = lite3_iter_next(ctx->buf, ctx->buflen, &iter, NULL, &val_ofs);
+        if (ret < 0) {
+            tron_raise_errno("lite3_iter_next");
+            return -1;
+        }
+        if (ret != LITE3_ITER_ITEM) {
+            break;
+        }
+        if (index < start) {
+            continue;
+        }
 
-    if (written != self->ctx->buflen) {
-        errno = saved_errno;
-        return tron_raise_errno("fwrite");
+        PyObject *item = tron_val_to_view(self->tron, (const lite3_val *)(ctx->buf + val_ofs));
+        if (!item) {
+            return -1;
+        }
+        int cmp = PyObject_RichCompareBool(item, value, Py_EQ);
+        Py_DECREF(item);
+        if (cmp < 0) {
+            return -1;
+        }
+        if (self->tron->version != version) {
+            PyErr_SetString(PyExc_RuntimeError, "Tron changed during iteration");
+            return -1;
+        }
+        if (cmp) {
+            if (find) {
+                return index;
+            }
+            matches++;
+        }
     }
 
-    Py_RETURN_NONE;
+    return find ? -2 : matches;
 }
 
-static PyObject *Tron_debug_fill(TronObject *self, PyObject *args)
+static int TronList_contains(TronViewObject *self, PyObject *value)
 {
-    unsigned int value = 0;
-    if (!PyArg_ParseTuple(args, "I", &value)) {
-        return NULL;
-    }
-
-    memset(self->ctx->buf, (int)(value & 0xFF), self->ctx->bufsz);
-    Py_RETURN_NONE;
+    Py_ssize_t index = tron_list_scan(self, value, 0, PY_SSIZE_T_MAX, true);
+    return index == -1 ? -1 : index >= 0;
 }
 
-static PyObject *Tron_from_bytes(PyTypeObject *type, PyObject *args)
+static PyObject *TronList_index(TronViewObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    Py_buffer view;
-    if (!PyArg_ParseTuple(args, "y*", &view)) {
+    TRON_ARGPARSER(parser, "index", 1, "value", "start", "stop");
+    PyObject *argv[3];
+    Py_ssize_t start = 0;
+    Py_ssize_t stop = PY_SSIZE_T_MAX;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
         return NULL;
     }
-
-    lite3_ctx *ctx = lite3_ctx_create_from_buf((const unsigned char *)view.buf, (size_t)view.len);
-    PyBuffer_Release(&view);
-
-    if (!ctx) {
-        return tron_raise_errno("lite3_ctx_create_from_buf");
+    if (tron_arg_ssize(argv[1], &start) < 0 || tron_arg_ssize(argv[2], &stop) < 0) {
+        return NULL;
+    }
+    if (start < 0 || stop < 0) {
+        Py_ssize_t count = TronView_length(self);
+        if (count < 0) {
+            return NULL;
+        }
+        start = start < 0 ? Py_MAX(start + count, 0) : start;
+        stop = stop < 0 ? Py_MAX(stop + count, 0) : stop;
     }
 
-    TronObject *self = tron_create_with_ctx(type, ctx);
-    if (!self) {
-        lite3_ctx_destroy(ctx);
+    Py_ssize_t index = tron_list_scan(self, argv[0], start, stop, true);
+    if (index == -1) {
         return NULL;
     }
+    if (index == -2) {
+        PyErr_SetString(PyExc_ValueError, "value is not in TronList");
+        return NULL;
+    }
+    return PyLong_FromSsize_t(index);
+}
 
-    return (PyObject *)self;
+static PyObject *TronList_count(TronViewObject *self, PyObject *value)
+{
+    Py_ssize_t matches = tron_list_scan(self, value, 0, PY_SSIZE_T_MAX, false);
+    return matches < 0 ? NULL : PyLong_FromSsize_t(matches);
 }
 
-static PyObject *Tron_from_json(PyTypeObject *type, PyObject *args)
+static PyObject *TronList_iter(TronViewObject *self)
 {
-    PyObject *json_obj = NULL;
-    if (!PyArg_ParseTuple(args, "O", &json_obj)) {
+    if (tron_view_check(self) < 0) {
         return NULL;
     }
+    return tron_iter_new(self->tron, self->ofs, TRON_ITER_VALUES, true);
+}
 
-    Py_ssize_t json_len = 0;
-    const char *json_str = PyUnicode_AsUTF8AndSize(json_obj, &json_len);
-    if (!json_str) {
-        return NULL;
+TRON_LOCKED(PyObject *, NULL, TronList_item, self->tron, (TronViewObject *self, Py_ssize_t index), (self, index))
+TRON_LOCKED(PyObject *, NULL, TronList_subscript, self->tron, (TronViewObject *self, PyObject *item), (self, item))
+TRON_LOCKED(int, -1, TronList_contains, self->tron, (TronViewObject *self, PyObject *value), (self, value))
+TRON_LOCKED(PyObject *, NULL, TronList_index, self->tron,
+            (TronViewObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames),
+            (self, args, nargs, kwnames))
+TRON_LOCKED(PyObject *, NULL, TronList_count, self->tron, (TronViewObject *self, PyObject *value), (self, value))
+TRON_LOCKED(PyObject *, NULL, TronList_iter, self->tron, (TronViewObject *self), (self))
+
+static PySequenceMethods TronList_as_sequence = {
+    .sq_length = (lenfunc)TronView_length_locked,
+    .sq_item = (ssizeargfunc)TronList_item_locked,
+    .sq_contains = (objobjproc)TronList_contains_locked,
+};
+
+static PyMappingMethods TronList_as_mapping = {
+    .mp_length = (lenfunc)TronView_length_locked,
+    .mp_subscript = (binaryfunc)TronList_subscript_locked,
+};
+
+static PyMethodDef TronList_methods[] = {
+    {"index", (PyCFunction)TronList_index_locked, METH_FASTCALL | METH_KEYWORDS, "First index of value."},
+    {"count", (PyCFunction)TronList_count_locked, METH_O, "Number of occurrences of value."},
+    {"to_obj", (PyCFunction)TronView_to_obj_locked, METH_NOARGS, "Materialize the array as a list."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject TronListType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.TronList",
+    .tp_basicsize = sizeof(TronViewObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_SEQUENCE,
+    .tp_doc = "Read-only Sequence view of a Tron array; nested containers are views too",
+    .tp_methods = TronList_methods,
+    .tp_getset = TronView_getset,
+    .tp_as_sequence = &TronList_as_sequence,
+    .tp_as_mapping = &TronList_as_mapping,
+    .tp_iter = (getiterfunc)TronList_iter_locked,
+    .tp_richcompare = TronView_richcompare,
+    .tp_hash = PyObject_HashNotImplemented,
+    .tp_repr = (reprfunc)TronView_repr,
+    .tp_dealloc = (destructor)TronView_dealloc,
+};
+
+/* Registers the views with collections.abc and caches the Mapping view classes. */
+static int tron_register_abcs(void)
+{
+    PyObject *abc = PyImport_ImportModule("collections.abc");
+    if (!abc) {
+        return -1;
     }
 
-    lite3_ctx *ctx = lite3_ctx_create();
-    if (!ctx) {
-        return tron_raise_errno("lite3_ctx_create");
+    int ret = -1;
+    PyObject *mapping = PyObject_GetAttrString(abc, "Mapping");
+    PyObject *sequence = PyObject_GetAttrString(abc, "Sequence");
+    if (!mapping || !sequence) {
+        goto done;
     }
 
-    if (lite3_ctx_json_dec(ctx, json_str, (size_t)json_len) < 0) {
-        tron_raise_errno("lite3_ctx_json_dec");
-        lite3_ctx_destroy(ctx);
-        return NULL;
+    PyObject *registered = PyObject_CallMethod(mapping, "register", "O", (PyObject *)&TronDictType);
+    if (!registered) {
+        goto done;
+    }
+    Py_DECREF(registered);
+    registered = PyObject_CallMethod(sequence, "register", "O", (PyObject *)&TronListType);
+    if (!registered) {
+        goto done;
     }
+    Py_DECREF(registered);
 
-    TronObject *self = tron_create_with_ctx(type, ctx);
-    if (!self) {
-        lite3_ctx_destroy(ctx);
-        return NULL;
+    AbcKeysView = PyObject_GetAttrString(abc, "KeysView");
+    AbcValuesView = PyObject_GetAttrString(abc, "ValuesView");
+    AbcItemsView = PyObject_GetAttrString(abc, "ItemsView");
+    if (AbcKeysView && AbcValuesView && AbcItemsView) {
+        ret = 0;
     }
 
-    return (PyObject *)self;
+done:
+    Py_XDECREF(mapping);
+    Py_XDECREF(sequence);
+    Py_DECREF(abc);
+    return ret;
 }
 
-static PyObject *Tron_from_json_file(PyTypeObject *type, PyObject *args)
+/* iter_ndjson(): the source is read in chunk_size blocks into one growable buffer and
+ * split on '\n' with memchr, so the only per-line Python work is the yielded object. */
+typedef struct {
+    PyObject_HEAD
+    PyObject *fileobj;
+    FILE *fp;
+    char *buf;
+    size_t cap;
+    size_t start;
+    size_t end;
+    Py_ssize_t lineno;
+    bool eof;
+    bool reuse;
+    /* Set while a next() runs; fread/readinto detach and would let another one in. */
+    bool running;
+    TronObject *tron;
+} NdjsonIterObject;
+
+static PyTypeObject NdjsonIterType;
+
+/* Lines at least this long are decoded with the GIL released. */
+#define TRON_NDJSON_NOGIL_MIN (64 * 1024)
+
+static int ndjson_fill(NdjsonIterObject *self)
 {
-    const char *path = NULL;
-    if (!PyArg_ParseTuple(args, "s", &path)) {
-        return NULL;
+    if (self->start > 0) {
+        memmove(self->buf, self->buf + self->start, self->end - self->start);
+        self->end -= self->start;
+        self->start = 0;
+    }
+    if (self->end == self->cap) {
+        char *grown = (char *)realloc(self->buf, self->cap * 2);
+        if (!grown) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->buf = grown;
+        self->cap *= 2;
+    }
+
+    size_t room = self->cap - self->end;
+    size_t n = 0;
+    if (self->fp) {
+        int failed = 0;
+        Py_BEGIN_ALLOW_THREADS
+        n = fread(self->buf + self->end, 1, room, self->fp);
+        failed = n == 0 && ferror(self->fp);
+        Py_END_ALLOW_THREADS
+        if (failed) {
+            tron_raise_errno("fread");
+            return -1;
+        }
+    } else {
+        PyObject *view = PyMemoryView_FromMemory(self->buf + self->end, (Py_ssize_t)room, PyBUF_WRITE);
+        if (!view) {
+            return -1;
+        }
+        PyObject *result = PyObject_CallMethod(self->fileobj, "readinto", "O", view);
+        PyObject *released = PyObject_CallMethod(view, "release", NULL);
+        Py_DECREF(view);
+        if (!released) {
+            /* The view is still exported: leak the buffer rather than realloc or free live
+             * memory, and end the iteration. */
+            Py_XDECREF(result);
+            self->buf = NULL;
+            self->cap = self->start = self->end = 0;
+            self->eof = true;
+            return -1;
+        }
+        Py_DECREF(released);
+        if (!result) {
+            return -1;
+        }
+        /* None is a non-blocking raw stream with no data yet, not end of file. */
+        if (result == Py_None) {
+            Py_DECREF(result);
+            PyErr_SetString(PyExc_BlockingIOError, "readinto() returned None: the file would block");
+            return -1;
+        }
+        Py_ssize_t got = PyLong_AsSsize_t(result);
+        Py_DECREF(result);
+        if (got < 0 || (size_t)got > room) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError, "readinto() returned an invalid size");
+            }
+            return -1;
+        }
+        n = (size_t)got;
     }
 
-    lite3_ctx *ctx = lite3_ctx_create();
-    if (!ctx) {
-        return tron_raise_errno("lite3_ctx_create");
+    if (n == 0) {
+        self->eof = true;
     }
+    self->end += n;
+    return 0;
+}
 
-    if (lite3_ctx_json_dec_file(ctx, path) < 0) {
-        tron_raise_errno("lite3_ctx_json_dec_file");
-        lite3_ctx_destroy(ctx);
-        return NULL;
+static PyObject *ndjson_decode(NdjsonIterObject *self, const char *line, size_t len)
+{
+    const char *failed = NULL;
+
+    if (self->reuse && self->tron) {
+        int ret = 0;
+        Py_BEGIN_CRITICAL_SECTION(self->tron);
+        Py_ssize_t depth = tron_lock_held(self->tron);
+        ret = tron_check_mutable(self->tron);
+        if (ret == 0 && lite3_ctx_json_dec(self->tron->ctx, line, len) < 0) {
+            failed = "lite3_ctx_json_dec";
+            ret = -1;
+        }
+        tron_unlock_to(self->tron, depth);
+        Py_END_CRITICAL_SECTION();
+        if (ret < 0) {
+            goto error;
+        }
+        return Py_NewRef(self->tron);
     }
 
-    TronObject *self = tron_create_with_ctx(type, ctx);
-    if (!self) {
+    lite3_ctx *ctx = NULL;
+    if (len >= TRON_NDJSON_NOGIL_MIN) {
+        Py_BEGIN_ALLOW_THREADS
+        ctx = tron_decode_json(line, len, &failed);
+        Py_END_ALLOW_THREADS
+    } else {
+        ctx = tron_decode_json(line, len, &failed);
+    }
+    if (!ctx) {
+        goto error;
+    }
+
+    TronObject *tron = tron_create_with_ctx(&TronType, ctx);
+    if (!tron) {
         lite3_ctx_destroy(ctx);
         return NULL;
     }
+    if (self->reuse) {
+        self->tron = (TronObject *)Py_NewRef(tron);
+    }
+    return (PyObject *)tron;
 
-    return (PyObject *)self;
+error:
+    if (failed) {
+        int err = errno;
+        PyErr_Format(TronError, "line %zd: %s: %s", self->lineno, failed, err ? strerror(err) : "failed");
+    }
+    return NULL;
 }
 
-static PyObject *Tron_from_file(PyTypeObject *type, PyObject *args)
+static PyObject *NdjsonIter_next(NdjsonIterObject *self)
 {
-    const char *path = NULL;
-    if (!PyArg_ParseTuple(args, "s", &path)) {
+    if (!self->buf) {
         return NULL;
     }
+    for (;;) {
+        char *line = self->buf + self->start;
+        char *nl = (char *)memchr(line, '\n', self->end - self->start);
+        size_t len;
+
+        if (nl) {
+            len = (size_t)(nl - line);
+            self->start += len + 1;
+        } else if (!self->eof) {
+            if (ndjson_fill(self) < 0) {
+                return NULL;
+            }
+            continue;
+        } else if (self->start < self->end) {
+            len = self->end - self->start;
+            self->start = self->end;
+        } else {
+            return NULL;
+        }
 
-    FILE *fp = fopen(path, "rb");
-    if (!fp) {
-        return tron_raise_errno("fopen");
+        self->lineno++;
+        while (len > 0 && (line[len - 1] == '\r' || line[len - 1] == ' ' || line[len - 1] == '\t')) {
+            len--;
+        }
+        while (len > 0 && (*line == ' ' || *line == '\t')) {
+            line++;
+            len--;
+        }
+        if (len > 0) {
+            return ndjson_decode(self, line, len);
+        }
     }
+}
 
-    if (fseek(fp, 0, SEEK_END) != 0) {
-        int saved_errno = errno;
-        fclose(fp);
-        errno = saved_errno;
-        return tron_raise_errno("fseek");
+static PyObject *NdjsonIter_next_locked(NdjsonIterObject *self)
+{
+    PyObject *result = NULL;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (self->running) {
+        PyErr_SetString(PyExc_ValueError, "NDJSON iterator already executing");
+    } else {
+        self->running = true;
+        result = NdjsonIter_next(self);
+        self->running = false;
     }
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
 
-    long size = ftell(fp);
-    if (size < 0) {
-        int saved_errno = errno;
-        fclose(fp);
-        errno = saved_errno;
-        return tron_raise_errno("ftell");
+static void NdjsonIter_dealloc(NdjsonIterObject *self)
+{
+    if (self->fp) {
+        fclose(self->fp);
     }
+    free(self->buf);
+    Py_XDECREF(self->fileobj);
+    Py_XDECREF(self->tron);
+    PyObject_Free(self);
+}
 
-    if (fseek(fp, 0, SEEK_SET) != 0) {
-        int saved_errno = errno;
-        fclose(fp);
-        errno = saved_errno;
-        return tron_raise_errno("fseek");
-    }
+static PyTypeObject NdjsonIterType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "tron.NdjsonIterator",
+    .tp_basicsize = sizeof(NdjsonIterObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Iterator decoding one Tron per line of an NDJSON / JSON Lines source",
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc)NdjsonIter_next_locked,
+    .tp_dealloc = (destructor)NdjsonIter_dealloc,
+};
 
-    if (size == 0) {
-        fclose(fp);
-        PyErr_SetString(TronError, "file is empty");
+static PyObject *tron_iter_ndjson(PyObject *Py_UNUSED(module), PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    TRON_ARGPARSER(parser, "iter_ndjson", 1, "source", "chunk_size", "reuse");
+    PyObject *argv[3];
+    Py_ssize_t chunk_size = 1 << 20;
+    int reuse = 0;
+
+    if (tron_parse_args(&parser, args, nargs, kwnames, argv) < 0) {
         return NULL;
     }
-
-    unsigned char *buf = (unsigned char *)malloc((size_t)size);
-    if (!buf) {
-        fclose(fp);
-        return tron_raise_errno("malloc");
+    if (tron_arg_ssize(argv[1], &chunk_size) < 0 || tron_arg_bool(argv[2], &reuse) < 0) {
+        return NULL;
     }
-
-    size_t read = fread(buf, 1, (size_t)size, fp);
-    int saved_errno = errno;
-    fclose(fp);
-
-    if (read != (size_t)size) {
-        free(buf);
-        errno = saved_errno;
-        return tron_raise_errno("fread");
+    if (chunk_size <= 0) {
+        PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+        return NULL;
     }
 
-    lite3_ctx *ctx = lite3_ctx_create_from_buf(buf, (size_t)size);
-    free(buf);
-
-    if (!ctx) {
-        return tron_raise_errno("lite3_ctx_create_from_buf");
+    PyObject *source = argv[0];
+    FILE *fp = NULL;
+    if (PyUnicode_Check(source) || PyBytes_Check(source) || PyObject_HasAttrString(source, "__fspath__")) {
+        PyObject *path = NULL;
+        if (!PyUnicode_FSConverter(source, &path)) {
+            return NULL;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        fp = fopen(PyBytes_AS_STRING(path), "rb");
+        Py_END_ALLOW_THREADS
+        Py_DECREF(path);
+        if (!fp) {
+            return tron_raise_errno("fopen");
+        }
+    } else if (!PyObject_HasAttrString(source, "readinto")) {
+        PyErr_SetString(PyExc_TypeError, "source must be a path or a binary file object with readinto()");
+        return NULL;
     }
 
-    TronObject *self = tron_create_with_ctx(type, ctx);
-    if (!self) {
-        lite3_ctx_destroy(ctx);
+    NdjsonIterObject *it = PyObject_New(NdjsonIterObject, &NdjsonIterType);
+    if (!it) {
+        if (fp) {
+            fclose(fp);
+        }
         return NULL;
     }
-
-    return (PyObject *)self;
+    it->fileobj = fp ? NULL : Py_NewRef(source);
+    it->fp = fp;
+    it->cap = (size_t)chunk_size;
+    it->start = 0;
+    it->end = 0;
+    it->lineno = 0;
+    it->eof = false;
+    it->running = false;
+    it->reuse = reuse != 0;
+    it->tron = NULL;
+    it->buf = (char *)malloc(it->cap);
+    if (!it->buf) {
+        Py_DECREF(it);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)it;
 }
 
-static PyMethodDef Tron_methods[] = {
-    {"init_obj", (PyCFunction)Tron_init_obj, METH_NOARGS, "Initialize root as object."},
-    {"init_arr", (PyCFunction)Tron_init_arr, METH_NOARGS, "Initialize root as array."},
-    {"set_null", (PyCFunction)Tron_set_null, METH_VARARGS | METH_KEYWORDS, "Set null value in object."},
-    {"set_bool", (PyCFunction)Tron_set_bool, METH_VARARGS | METH_KEYWORDS, "Set boolean value in object."},
-    {"set_i64", (PyCFunction)Tron_set_i64, METH_VARARGS | METH_KEYWORDS, "Set int64 value in object."},
-    {"set_f64", (PyCFunction)Tron_set_f64, METH_VARARGS | METH_KEYWORDS, "Set float value in object."},
-    {"set_bytes", (PyCFunction)Tron_set_bytes, METH_VARARGS | METH_KEYWORDS, "Set bytes value in object."},
-    {"set_str", (PyCFunction)Tron_set_str, METH_VARARGS | METH_KEYWORDS, "Set string value in object."},
-    {"set_obj", (PyCFunction)Tron_set_obj, METH_VARARGS | METH_KEYWORDS, "Set nested object and return its offset."},
-    {"set_arr", (PyCFunction)Tron_set_arr, METH_VARARGS | METH_KEYWORDS, "Set nested array and return its offset."},
-    {"delete", (PyCFunction)Tron_set_null, METH_VARARGS | METH_KEYWORDS, "Delete a key by setting null."},
-    {"get_bool", (PyCFunction)Tron_get_bool, METH_VARARGS | METH_KEYWORDS, "Get boolean value by key."},
-    {"get_i64", (PyCFunction)Tron_get_i64, METH_VARARGS | METH_KEYWORDS, "Get int64 value by key."},
-    {"get_f64", (PyCFunction)Tron_get_f64, METH_VARARGS | METH_KEYWORDS, "Get float value by key."},
-    {"get_bytes", (PyCFunction)Tron_get_bytes, METH_VARARGS | METH_KEYWORDS, "Get bytes value by key."},
-    {"get_str", (PyCFunction)Tron_get_str, METH_VARARGS | METH_KEYWORDS, "Get string value by key."},
-    {"get_obj", (PyCFunction)Tron_get_obj, METH_VARARGS | METH_KEYWORDS, "Get nested object offset by key."},
-    {"get_arr", (PyCFunction)Tron_get_arr, METH_VARARGS | METH_KEYWORDS, "Get nested array offset by key."},
-    {"get_type", (PyCFunction)Tron_get_type, METH_VARARGS | METH_KEYWORDS, "Get value type by key."},
-    {"get", (PyCFunction)Tron_get, METH_VARARGS | METH_KEYWORDS, "Get value by key and return a Python type."},
-    {"exists", (PyCFunction)Tron_exists, METH_VARARGS | METH_KEYWORDS, "Check if a key exists."},
-    {"arr_append_null", (PyCFunction)Tron_arr_append_null, METH_VARARGS | METH_KEYWORDS, "Append null to array."},
-    {"arr_append_bool", (PyCFunction)Tron_arr_append_bool, METH_VARARGS | METH_KEYWORDS, "Append boolean to array."},
-    {"arr_append_i64", (PyCFunction)Tron_arr_append_i64, METH_VARARGS | METH_KEYWORDS, "Append int64 to array."},
-    {"arr_append_f64", (PyCFunction)Tron_arr_append_f64, METH_VARARGS | METH_KEYWORDS, "Append float to array."},
-    {"arr_append_bytes", (PyCFunction)Tron_arr_append_bytes, METH_VARARGS | METH_KEYWORDS, "Append bytes to array."},
-    {"arr_append_str", (PyCFunction)Tron_arr_append_str, METH_VARARGS | METH_KEYWORDS, "Append string to array."},
-    {"arr_append_obj", (PyCFunction)Tron_arr_append_obj, METH_VARARGS | METH_KEYWORDS, "Append object to array and return its offset."},
-    {"arr_append_arr", (PyCFunction)Tron_arr_append_arr, METH_VARARGS | METH_KEYWORDS, "Append array to array and return its offset."},
-    {"arr_get_bool", (PyCFunction)Tron_arr_get_bool, METH_VARARGS | METH_KEYWORDS, "Get boolean from array by index."},
-    {"arr_get_i64", (PyCFunction)Tron_arr_get_i64, METH_VARARGS | METH_KEYWORDS, "Get int64 from array by index."},
-    {"arr_get_f64", (PyCFunction)Tron_arr_get_f64, METH_VARARGS | METH_KEYWORDS, "Get float from array by index."},
-    {"arr_get_bytes", (PyCFunction)Tron_arr_get_bytes, METH_VARARGS | METH_KEYWORDS, "Get bytes from array by index."},
-    {"arr_get_str", (PyCFunction)Tron_arr_get_str, METH_VARARGS | METH_KEYWORDS, "Get string from array by index."},
-    {"arr_get_obj", (PyCFunction)Tron_arr_get_obj, METH_VARARGS | METH_KEYWORDS, "Get object offset from array by index."},
-    {"arr_get_arr", (PyCFunction)Tron_arr_get_arr, METH_VARARGS | METH_KEYWORDS, "Get array offset from array by index."},
-    {"to_bytes", (PyCFunction)Tron_to_bytes, METH_NOARGS, "Return raw buffer bytes."},
-    {"buflen", (PyCFunction)Tron_buflen, METH_NOARGS, "Return used buffer length."},
-    {"bufsz", (PyCFunction)Tron_bufsz, METH_NOARGS, "Return total buffer size."},
-    {"to_json", (PyCFunction)Tron_to_json, METH_VARARGS | METH_KEYWORDS, "Convert to JSON string."},
-    {"save", (PyCFunction)Tron_save, METH_VARARGS | METH_KEYWORDS, "Save raw buffer to file."},
-    {"debug_fill", (PyCFunction)Tron_debug_fill, METH_VARARGS, "Fill buffer with a byte value (testing)."},
-    {"from_bytes", (PyCFunction)Tron_from_bytes, METH_VARARGS | METH_CLASS, "Create Tron from raw bytes."},
-    {"from_json", (PyCFunction)Tron_from_json, METH_VARARGS | METH_CLASS, "Create Tron from JSON string."},
-    {"from_json_file", (PyCFunction)Tron_from_json_file, METH_VARARGS | METH_CLASS, "Create Tron from JSON file."},
-    {"from_file", (PyCFunction)Tron_from_file, METH_VARARGS | METH_CLASS, "Create Tron from raw buffer file."},
+static PyMethodDef tron_module_methods[] = {
+    {"iter_ndjson", (PyCFunction)tron_iter_ndjson, METH_FASTCALL | METH_KEYWORDS,
+     "Iterate NDJSON lines from a path or binary file as Tron objects."},
+    {"_unpickle", (PyCFunction)tron_unpickle, METH_FASTCALL, "Rebuild a pickled Tron."},
     {NULL, NULL, 0, NULL}
 };
 
-static PyTypeObject TronType = {
-    PyVarObject_HEAD_INIT(NULL, 0)
-    .tp_name = "tron.Tron",
-    .tp_basicsize = sizeof(TronObject),
-    .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_doc = "TRON (Lite3) context wrapper",
-    .tp_methods = Tron_methods,
-    .tp_init = (initproc)Tron_init,
-    .tp_new = PyType_GenericNew,
-    .tp_dealloc = (destructor)Tron_dealloc,
-};
-
-static PyModuleDef tronmodule = {
-    PyModuleDef_HEAD_INIT,
-    .m_name = "tron._tron",
-    .m_doc = "Python bindings for TRON (Lite3)",
-    .m_size = -1,
-};
-
-PyMODINIT_FUNC PyInit__tron(void)
+/* Types and TronError are process-wide statics, so the module opts out of per-interpreter
+ * isolation; it holds no state that needs the GIL. */
+static int tron_exec(PyObject *module)
 {
-    if (PyType_Ready(&TronType) < 0) {
-        return NULL;
+    PyTypeObject *types[] = {&TronType, &FrozenTronType, &KeyType, &PathType, &TronIterType, &TronDictType, &TronListType,
+                             &NdjsonIterType, &PoolType, &PredicateType};
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        if (PyType_Ready(types[i]) < 0) {
+            return -1;
+        }
     }
-
-    PyObject *module = PyModule_Create(&tronmodule);
-    if (!module) {
-        return NULL;
+    if (!AbcKeysView && tron_register_abcs() < 0) {
+        return -1;
+    }
+    if (!TronUnpickle && !(TronUnpickle = PyObject_GetAttrString(module, "_unpickle"))) {
+        return -1;
     }
 
-    TronError = PyErr_NewException("tron.TronError", NULL, NULL);
     if (!TronError) {
-        Py_DECREF(module);
-        return NULL;
+        TronError = PyErr_NewException("tron.TronError", NULL, NULL);
+        if (!TronError) {
+            return -1;
+        }
     }
 
-    Py_INCREF(TronError);
-    if (PyModule_AddObject(module, "TronError", TronError) < 0) {
-        Py_DECREF(TronError);
-        Py_DECREF(module);
-        return NULL;
+    if (PyModule_AddObjectRef(module, "TronError", TronError) < 0 ||
+        PyModule_AddObjectRef(module, "Tron", (PyObject *)&TronType) < 0 ||
+        PyModule_AddObjectRef(module, "FrozenTron", (PyObject *)&FrozenTronType) < 0 ||
+        PyModule_AddObjectRef(module, "Key", (PyObject *)&KeyType) < 0 ||
+        PyModule_AddObjectRef(module, "Pool", (PyObject *)&PoolType) < 0 ||
+        PyModule_AddObjectRef(module, "Path", (PyObject *)&PathType) < 0 ||
+        PyModule_AddObjectRef(module, "Predicate", (PyObject *)&PredicateType) < 0 ||
+        PyModule_AddObjectRef(module, "TronDict", (PyObject *)&TronDictType) < 0 ||
+        PyModule_AddObjectRef(module, "TronList", (PyObject *)&TronListType) < 0) {
+        return -1;
     }
 
-    Py_INCREF(&TronType);
-    if (PyModule_AddObject(module, "Tron", (PyObject *)&TronType) < 0) {
-        Py_DECREF(&TronType);
-        Py_DECREF(module);
-        return NULL;
+    if (PyModule_AddStringConstant(module, "__version__", TRON_MODULE_VERSION) < 0 ||
+        PyModule_AddIntConstant(module, "LITE3_NODE_SIZE", (long)LITE3_NODE_SIZE) < 0 ||
+        PyModule_AddIntConstant(module, "LITE3_NODE_ALIGNMENT", (long)LITE3_NODE_ALIGNMENT) < 0 ||
+        PyModule_AddIntConstant(module, "LITE3_ZERO_MEM_8", (long)LITE3_ZERO_MEM_8) < 0 ||
+        PyModule_AddIntConstant(module, "DJB2_HASH_SEED", (long)LITE3_DJB2_HASH_SEED) < 0) {
+        return -1;
     }
+    return 0;
+}
+
+static PyModuleDef_Slot tron_slots[] = {
+    {Py_mod_exec, tron_exec},
+    {Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_NOT_SUPPORTED},
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    {0, NULL}
+};
 
-    PyModule_AddStringConstant(module, "__version__", TRON_MODULE_VERSION);
-    PyModule_AddIntConstant(module, "LITE3_NODE_SIZE", (long)LITE3_NODE_SIZE);
-    PyModule_AddIntConstant(module, "LITE3_NODE_ALIGNMENT", (long)LITE3_NODE_ALIGNMENT);
-    PyModule_AddIntConstant(module, "LITE3_ZERO_MEM_8", (long)LITE3_ZERO_MEM_8);
-    PyModule_AddIntConstant(module, "DJB2_HASH_SEED", (long)LITE3_DJB2_HASH_SEED);
+static PyModuleDef tronmodule = {
+    PyModuleDef_HEAD_INIT,
+    .m_name = "tron._tron",
+    .m_doc = "Python bindings for TRON (Lite3)",
+    .m_size = 0,
+    .m_methods = tron_module_methods,
+    .m_slots = tron_slots,
+};
 
-    return module;
+PyMODINIT_FUNC PyInit__tron(void)
+{
+    return PyModuleDef_Init(&tronmodule);
 }
@@ -0,0 +1,171 @@
+"""Indexed multi-document TRON archives with O(1) lookup by id.
+
+Layout::
+
+    b"TRONARC1"
+    doc 0 | doc 1 | ...          each zero-padded to 8 bytes
+    key blob                      UTF-8 ids back to back, padded to 8 bytes
+    slot table                    open-addressing hash table, 32 bytes per slot
+    trailer                       <u64 count><u64 nslots><u64 table_ofs>b"TRONIDX1"
+
+A slot is ``<u32 crc32(id)><u32 id_len><u64 id_ofs><u64 doc_ofs><u64 doc_len>``;
+``doc_len == 0`` marks an empty slot. The table is read straight from the mmap, so
+opening an archive costs the same whether it holds ten documents or ten million.
+"""
+
+import mmap
+import os
+import struct
+import zlib
+from collections.abc import Iterator, Mapping
+from typing import BinaryIO
+
+from ._tron import FrozenTron, Tron, TronError
+
+ARCHIVE_MAGIC = b"TRONARC1"
+INDEX_MAGIC = b"TRONIDX1"
+_SLOT = struct.Struct("<IIQQQ")
+_TRAILER = struct.Struct("<QQQ8s")
+_ALIGN = 8
+
+
+def _padding(length: int) -> int:
+    return -length % _ALIGN
+
+
+class ArchiveWriter:
+    """Streams documents into an archive; only the (id, offset, length) index stays in memory."""
+
+    def __init__(self, path: str | os.PathLike):
+        self._fp: BinaryIO = open(path, "wb")
+        self._fp.write(ARCHIVE_MAGIC)
+        self._pos = len(ARCHIVE_MAGIC)
+        self._index: dict[str, tuple[int, int]] = {}
+
+    def add(self, doc_id: str, tron: Tron) -> None:
+        if not isinstance(doc_id, str):
+            raise TypeError(f"archive ids must be str, not {type(doc_id).__name__}")
+        if doc_id in self._index:
+            raise ValueError(f"duplicate archive id {doc_id!r}")
+        with memoryview(tron) as data:
+            length = len(data)
+            self._fp.write(data)
+        self._fp.write(bytes(_padding(length)))
+        self._index[doc_id] = (self._pos, length)
+        self._pos += length + _padding(length)
+
+    def __len__(self) -> int:
+        return len(self._index)
+
+    def close(self) -> None:
+        if self._fp.closed:
+            return
+        count = len(self._index)
+        nslots = 1
+        while nslots < count * 2:
+            nslots *= 2
+
+        keys = bytearray()
+        key_base = self._pos
+        table = bytearray(_SLOT.size * nslots)
+        mask = nslots - 1
+        for doc_id, (doc_ofs, doc_len) in self._index.items():
+            raw = doc_id.encode()
+            crc = zlib.crc32(raw)
+            slot = crc & mask
+            while _SLOT.unpack_from(table, slot * _SLOT.size)[4]:
+                slot = (slot + 1) & mask
+            _SLOT.pack_into(table, slot * _SLOT.size, crc, len(raw), key_base + len(keys), doc_ofs, doc_len)
+            keys += raw
+        keys += bytes(_padding(len(keys)))
+
+        table_ofs = key_base + len(keys)
+        self._fp.write(keys)
+        self._fp.write(table)
+        self._fp.write(_TRAILER.pack(count, nslots, table_ofs, INDEX_MAGIC))
+        self._fp.close()
+
+    def __enter__(self) -> "ArchiveWriter":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+
+class Archive(Mapping):
+    """Read-only mmap of an archive; ``archive[id]`` is a zero-copy :class:`FrozenTron`."""
+
+    def __init__(self, mapping: mmap.mmap):
+        self._mm = mapping
+        if len(mapping) < len(ARCHIVE_MAGIC) + _TRAILER.size or mapping[: len(ARCHIVE_MAGIC)] != ARCHIVE_MAGIC:
+            raise TronError("not a TRON archive (bad magic)")
+        count, nslots, table_ofs, magic = _TRAILER.unpack_from(mapping, len(mapping) - _TRAILER.size)
+        if magic != INDEX_MAGIC or table_ofs + nslots * _SLOT.size != len(mapping) - _TRAILER.size:
+            raise TronError("corrupt TRON archive index")
+        if nslots & (nslots - 1):
+            raise TronError("corrupt TRON archive index")
+        self._count = count
+        self._nslots = nslots
+        self._table_ofs = table_ofs
+
+    @classmethod
+    def open(cls, path: str | os.PathLike) -> "Archive":
+        with open(path, "rb") as fp:
+            if os.fstat(fp.fileno()).st_size == 0:
+                raise TronError(f"not a TRON archive (empty file): {os.fspath(path)!r}")
+            return cls(mmap.mmap(fp.fileno(), 0, access=mmap.ACCESS_READ))
+
+    def _find(self, doc_id: str) -> tuple[int, int] | None:
+        raw = doc_id.encode()
+        crc = zlib.crc32(raw)
+        mask = self._nslots - 1
+        slot = crc & mask
+        mm = self._mm
+        unpack = _SLOT.unpack_from
+        # The writer leaves at least half the slots empty, so a full table is corrupt.
+        for _ in range(self._nslots):
+            slot_crc, id_len, id_ofs, doc_ofs, doc_len = unpack(mm, self._table_ofs + slot * _SLOT.size)
+            if not doc_len:
+                return None
+            if slot_crc == crc and id_len == len(raw) and mm[id_ofs : id_ofs + id_len] == raw:
+                return doc_ofs, doc_len
+            slot = (slot + 1) & mask
+        raise TronError("corrupt TRON archive index (no empty slot)")
+
+    def __getitem__(self, doc_id: str) -> FrozenTron:
+        if not isinstance(doc_id, str):
+            raise KeyError(doc_id)
+        found = self._find(doc_id)
+        if found is None:
+            raise KeyError(doc_id)
+        return FrozenTron.from_buffer(self._mm, found[0], found[1])
+
+    def __contains__(self, doc_id: object) -> bool:
+        return isinstance(doc_id, str) and self._find(doc_id) is not None
+
+    def __len__(self) -> int:
+        return self._count
+
+    def __iter__(self) -> Iterator[str]:
+        """Ids in the order they were added."""
+        entries = []
+        for slot in range(self._nslots):
+            _, id_len, id_ofs, doc_ofs, doc_len = _SLOT.unpack_from(self._mm, self._table_ofs + slot * _SLOT.size)
+            if doc_len:
+                entries.append((doc_ofs, id_ofs, id_len))
+        entries.sort()
+        for _, id_ofs, id_len in entries:
+            yield self._mm[id_ofs : id_ofs + id_len].decode()
+
+    def close(self) -> None:
+        """Unmaps the archive; documents still alive keep the mapping open until freed."""
+        try:
+            self._mm.close()
+        except BufferError:
+            pass
+
+    def __enter__(self) -> "Archive":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
@@ -1,4 +1,4 @@
-import json
+from collections.abc import Mapping
 from typing import Any
 
 from ._tron import Tron
@@ -17,30 +17,35 @@ class TronDocument:
     def __getattr__(self, name):
         return getattr(self._tron, name)
 
+    def __len__(self) -> int:
+        return len(self._tron)
+
+    def __iter__(self):
+        return iter(self._tron)
+
+    def __getitem__(self, item):
+        return self._tron[item]
+
+    def __contains__(self, item) -> bool:
+        return item in self._tron
+
     @classmethod
-    def from_obj(cls, obj: Any) -> "TronDocument":
-        doc = cls(root="object")
-        if isinstance(obj, dict):
-            doc._tron.init_obj()
-            doc.set_value_map(obj)
-            return doc
-        if isinstance(obj, (list, tuple)):
-            doc._tron.init_arr()
-            doc.append_value_list(obj)
-            return doc
-        raise TypeError("root value must be dict or list")
+    def from_obj(cls, obj: Any, *, bufsz_hint: int | None = None) -> "TronDocument":
+        doc = cls.__new__(cls)
+        doc._tron = Tron.from_obj(obj, bufsz_hint)
+        return doc
 
     def to_obj(self) -> Any:
-        return json.loads(self._tron.to_json())
+        return self._tron.to_obj()
 
     def set_value(self, key: str, value: Any, *, ofs: int = 0) -> None:
         if not isinstance(key, str):
             raise TypeError("object keys must be strings")
         _set_value(self._tron, key, value, ofs)
 
-    def set_value_map(self, mapping: dict, *, ofs: int = 0) -> None:
-        for key, value in mapping.items():
-            self.set_value(key, value, ofs=ofs)
+    def set_value_map(self, mapping: Mapping[str, Any], *, ofs: int = 0) -> None:
+        # set_many() reads a dict directly; other mappings go in as (key, value) pairs.
+        self._tron.set_many(mapping if isinstance(mapping, dict) else mapping.items(), ofs)
 
     def append_value(self, value: Any, *, ofs: int = 0) -> None:
         _append_value(self._tron, value, ofs)
@@ -50,26 +55,14 @@ class TronDocument:
             self.append_value(value, ofs=ofs)
 
 
-def from_obj(obj: Any) -> Tron:
+def from_obj(obj: Any, *, bufsz_hint: int | None = None) -> Tron:
     """Create a Tron instance from a dict or list without manual field setup."""
-    if isinstance(obj, dict):
-        tron = Tron(root="object")
-        tron.init_obj()
-        for key, value in obj.items():
-            _set_value(tron, key, value, 0)
-        return tron
-    if isinstance(obj, (list, tuple)):
-        tron = Tron(root="array")
-        tron.init_arr()
-        for value in obj:
-            _append_value(tron, value, 0)
-        return tron
-    raise TypeError("root value must be dict or list")
+    return Tron.from_obj(obj, bufsz_hint)
 
 
 def to_obj(tron: Tron) -> Any:
-    """Convert a Tron buffer to Python objects via JSON."""
-    return json.loads(tron.to_json())
+    """Convert a Tron buffer to Python objects; bytes values stay bytes."""
+    return tron.to_obj()
 
 
 def _set_value(tron: Tron, key: str, value: Any, ofs: int) -> None:
@@ -0,0 +1,181 @@
+"""Framed multi-document TRON streams.
+
+Layout: an 8-byte magic, then records of ``<u64 little-endian buflen><buf>`` with the
+buffer zero-padded to an 8-byte boundary, so every record starts aligned in an mmap.
+"""
+
+import mmap
+import os
+import struct
+from typing import BinaryIO, Iterable, Iterator
+
+from ._tron import FrozenTron, Tron, TronError, iter_ndjson
+
+STREAM_MAGIC = b"TRONSTR1"
+_HEADER = struct.Struct("<Q")
+_ALIGN = 8
+_PADS = [bytes(n) for n in range(_ALIGN)]
+
+
+def _padding(length: int) -> int:
+    return -length % _ALIGN
+
+
+class StreamWriter:
+    """Appends length-prefixed TRON buffers to a binary file object.
+
+    Records are staged in memory and handed to ``fileobj.write`` once per
+    ``buffer_size`` bytes (or per ``write_many`` call), not once per record.
+    """
+
+    def __init__(self, fileobj: BinaryIO, *, buffer_size: int = 1 << 20):
+        self._fileobj = fileobj
+        self._buffer_size = buffer_size
+        self._pending = bytearray()
+        self.count = 0
+        try:
+            fresh = fileobj.tell() == 0
+        except (AttributeError, OSError):
+            fresh = True
+        if fresh:
+            self._pending += STREAM_MAGIC
+
+    def _append(self, tron: Tron) -> None:
+        pending = self._pending
+        with memoryview(tron) as data:
+            length = len(data)
+            pending += _HEADER.pack(length)
+            pending += data
+        pending += _PADS[-length % _ALIGN]
+        self.count += 1
+
+    def write(self, tron: Tron) -> None:
+        self._append(tron)
+        if len(self._pending) >= self._buffer_size:
+            self.flush()
+
+    def write_many(self, trons: Iterable[Tron]) -> None:
+        for tron in trons:
+            self._append(tron)
+        self.flush()
+
+    def flush(self) -> None:
+        if self._pending:
+            self._fileobj.write(self._pending)
+            self._pending.clear()
+        flush = getattr(self._fileobj, "flush", None)
+        if flush is not None:
+            flush()
+
+    def close(self) -> None:
+        self.flush()
+
+    def __enter__(self) -> "StreamWriter":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+
+def ndjson_to_stream(source, fileobj: BinaryIO, *, chunk_size: int = 1 << 20) -> int:
+    """Converts an NDJSON path/binary file into a framed stream; returns the record count.
+
+    Every line is decoded into the same reused ``Tron``, so the conversion allocates no
+    per-record context.
+    """
+    with StreamWriter(fileobj) as writer:
+        for tron in iter_ndjson(source, chunk_size=chunk_size, reuse=True):
+            writer.write(tron)
+    return writer.count
+
+
+class StreamReader:
+    """Iterates the records of a stream written by :class:`StreamWriter`.
+
+    A path, ``mmap`` or other buffer yields zero-copy :class:`FrozenTron` records that
+    borrow the mapping; a file object is read sequentially and yields mutable ``Tron``
+    copies. Pass ``copy=True`` to always get ``Tron`` copies.
+    """
+
+    def __init__(self, source, *, copy: bool = False):
+        self._copy = copy
+        self._fileobj = None
+        self._mmap = None
+        self._buffer = None
+        if isinstance(source, (str, os.PathLike)):
+            with open(source, "rb") as fp:
+                size = os.fstat(fp.fileno()).st_size
+                self._mmap = mmap.mmap(fp.fileno(), 0, access=mmap.ACCESS_READ) if size else b""
+            self._buffer = self._mmap
+        elif hasattr(source, "read") and not isinstance(source, mmap.mmap):
+            self._fileobj = source
+        else:
+            self._buffer = source
+
+    def __iter__(self) -> Iterator[Tron]:
+        if self._fileobj is not None:
+            return self._iter_file()
+        return self._iter_buffer()
+
+    def _iter_buffer(self) -> Iterator[Tron]:
+        view = memoryview(self._buffer)
+        try:
+            end = len(view)
+            if end == 0:
+                return
+            if view[: len(STREAM_MAGIC)] != STREAM_MAGIC:
+                raise TronError("not a TRON stream (bad magic)")
+            pos = len(STREAM_MAGIC)
+            unpack = _HEADER.unpack_from
+            header = _HEADER.size
+            from_buffer = FrozenTron.from_buffer
+            copy = self._copy
+            while pos < end:
+                if pos + header > end:
+                    raise TronError(f"truncated record header at offset {pos}")
+                (length,) = unpack(view, pos)
+                pos += header
+                if pos + length > end:
+                    raise TronError(f"truncated record at offset {pos - header}")
+                if copy:
+                    yield Tron.from_bytes(view[pos : pos + length])
+                else:
+                    yield from_buffer(self._buffer, pos, length)
+                pos += length + _padding(length)
+        finally:
+            view.release()
+
+    def _iter_file(self) -> Iterator[Tron]:
+        read = self._fileobj.read
+        magic = read(len(STREAM_MAGIC))
+        if not magic:
+            return
+        if magic != STREAM_MAGIC:
+            raise TronError("not a TRON stream (bad magic)")
+        while True:
+            header = read(_HEADER.size)
+            if not header:
+                return
+            if len(header) != _HEADER.size:
+                raise TronError("truncated record header")
+            (length,) = _HEADER.unpack(header)
+            data = read(length + _padding(length))
+            if len(data) < length:
+                raise TronError("truncated record")
+            yield Tron.from_bytes(memoryview(data)[:length])
+
+    def close(self) -> None:
+        """Unmaps a path source; records still alive keep the mapping open until freed."""
+        if isinstance(self._mmap, mmap.mmap):
+            try:
+                self._mmap.close()
+            except BufferError:
+                pass
+        self._mmap = None
+        self._buffer = None
+
+    def __enter__(self) -> "StreamReader":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()